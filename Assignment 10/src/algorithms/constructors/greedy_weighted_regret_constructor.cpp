@@ -71,7 +71,7 @@ std::vector<int> greedy_weighted_regret_constructor(
                 double dist_ik = problem.get_distance(current_node_id, k);
                 double dist_kj = problem.get_distance(k, next_node_id);
                 double dist_ij = problem.get_distance(current_node_id, next_node_id);
-                double node_cost = problem.get_point(k).cost;
+                double node_cost = problem.get_cost(k);
 
                 // Cost change = (dist(i,k) + dist(k,j) - dist(i,j)) + cost(k)
                 double cost_change = dist_ik + dist_kj - dist_ij + node_cost;
@@ -30,7 +30,7 @@ namespace {
 double calculate_insertion_cost(int node, int prev, int next, const TSPProblem& problem) {
     // ASSUMPTION: TSPProblem has a method to get node cost. 
     // Adjust 'problem.get_node_cost(node)' to match your specific API (e.g., problem.costs[node]).
-    double node_cost = problem.get_point(node).cost; 
+    double node_cost = problem.get_cost(node); 
     
     // Distances (Euclidean rounded to int, as per problem description)
     double d_prev_node = problem.get_distance(prev, node);
@@ -225,7 +225,7 @@ std::vector<int> consensus_based_greedy_insertion(const std::vector<int>& parent
             // but for typical TSP sizes this O(N*K) is acceptable.
             for (size_t c = 0; c < candidates.size(); ++c) {
                 int cand = candidates[c];
-                double node_c = problem.get_point(cand).cost; 
+                double node_c = problem.get_cost(cand); 
 
                 for (size_t i = 0; i < offspring.size(); ++i) {
                     int prev = offspring[i];
@@ -266,7 +266,7 @@ std::vector<int> consensus_based_greedy_insertion(const std::vector<int>& parent
                 int prev = offspring[(i - 1 + offspring.size()) % offspring.size()];
                 int next = offspring[(i + 1) % offspring.size()];
 
-                double saving = problem.get_point(node).cost + 
+                double saving = problem.get_cost(node) + 
                                 (problem.get_distance(prev, node) + 
                                  problem.get_distance(node, next) - 
                                  problem.get_distance(prev, next));
@@ -33,7 +33,7 @@ std::vector<int> cost_priority_crossover(const std::vector<int>& parent1, const
     ranked_nodes.reserve(union_nodes.size());
     
     for (int node : union_nodes) {
-        ranked_nodes.push_back(NodeCostPair(node, (double)problem.get_point(node).cost));
+        ranked_nodes.push_back(NodeCostPair(node, (double)problem.get_cost(node)));
     }
     
     std::sort(ranked_nodes.begin(), ranked_nodes.end());
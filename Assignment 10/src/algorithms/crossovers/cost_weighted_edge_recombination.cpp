@@ -21,8 +21,7 @@ Edge make_edge(int u, int v) {
 // Helper to calculate the "cost" of moving to a node
 // We want to minimize: Node Cost + Edge Length
 double get_transition_cost(int from, int to, const TSPProblem& problem) {
-    // ASSUMPTION: TSPProblem has get_node_cost(int) and get_distance(int, int)
-    return problem.get_point(to).cost + problem.get_distance(from, to);
+    return problem.get_cost(to) + problem.get_distance(from, to);
 }
 
 std::vector<int> cost_weighted_edge_recombination(const std::vector<int>& parent1, const std::vector<int>& parent2, const TSPProblem& problem) {
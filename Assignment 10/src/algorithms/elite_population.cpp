@@ -30,6 +30,11 @@ bool ElitePopulation::try_add_solution(const std::vector<int>& solution) {
     return try_add_solution_internal(solution, eval);
 }
 
+bool ElitePopulation::try_add_solution(const std::vector<int>& solution, double evaluation) {
+    check_objective(solution, problem, evaluation, "ElitePopulation::try_add_solution");
+    return try_add_solution_internal(solution, evaluation);
+}
+
 std::pair<std::vector<int>, std::vector<int>> ElitePopulation::get_parents() {
     size_t N = population.size();
     
@@ -55,6 +55,15 @@ public:
      */
     bool try_add_solution(const std::vector<int>& solution);
 
+    /**
+     * @brief Attempts to add a new solution whose objective is already known.
+     * Same acceptance rules as try_add_solution, but skips the O(n) re-evaluation.
+     * @param solution The TSP path vector to attempt to add.
+     * @param evaluation The exact objective of `solution`.
+     * @return true if the solution was added; false if it was rejected (duplicate or too poor).
+     */
+    bool try_add_solution(const std::vector<int>& solution, double evaluation);
+
     /**
      * @brief Selects two parents from the population for crossover with tournament.
      * Uses tournament selection o select 2 different parents for crossover.
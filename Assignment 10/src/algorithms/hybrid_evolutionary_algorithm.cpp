@@ -1,34 +1,47 @@
 #include "hybrid_evolutionary_algorithm.h"
 #include <chrono>
 #include <random>
-#include <unordered_set>
 #include <cstdlib>
 
 #include "elite_population.h"
 // #include "constructors/random_solution.h" // Logic removed as it is now passed as parameter
 #include "local_search.h"
+#include "lin_kernighan_search.h"
+#include "parallel_local_search.h"
+#include "multi_move_local_search.h"
 #include "crossovers/stochastic_backbone_crossover.h"
 #include "crossovers/assymetric_repair_crossover.h"
 #include "intra_edge_exchange.h"
 #include "../core/stagetimer.h"
+#include "../core/evaluation.h"
 #include "large_neighborhood_search.h"
 
-// Helper function to get nodes not in solution
-std::vector<int> getNotInSolution(int size, const std::vector<int>& solution) {
-    std::unordered_set<int> solSet(solution.begin(), solution.end());
-    std::vector<int> not_in_solution;
-    not_in_solution.reserve(size);
-    for (int i = 0; i < size; ++i) {
-        if (solSet.find(i) == solSet.end()) {
-            not_in_solution.push_back(i);
-        }
-    }
-    return not_in_solution;
-}
+// Pair exchanges improved candidate-search optima on 200-node instances but led to worse ones
+// from 1000 nodes up, so the HEA only enables them below this size
+const int PAIR_EXCHANGE_MAX_NODES = 1000;
 
 // Mutation operator: performs perturbations
-void mutate_solution(std::vector<int>& solution, int total_nodes, int mutation_count = 10) {
+// The nodes outside the solution are kept in workspace.not_in_solution and the randomness comes
+// from workspace.rng, so a mutation allocates nothing.
+void mutate_solution(std::vector<int>& solution, int total_nodes, LocalSearchWorkspace& workspace, int mutation_count = 10) {
     int solution_size = solution.size();
+    std::mt19937& rng = workspace.rng;
+    auto random_below = [&rng](int bound) { return std::uniform_int_distribution<int>(0, bound - 1)(rng); };
+
+    // Nodes not in the solution, in increasing id order
+    workspace.reserve(total_nodes);
+    char* in_solution = workspace.in_solution.data();
+    std::fill(in_solution, in_solution + total_nodes, 0);
+    for (int node : solution) {
+        in_solution[node] = 1;
+    }
+    int* not_in_solution = workspace.not_in_solution.data();
+    int not_in_solution_size = 0;
+    for (int i = 0; i < total_nodes; ++i) {
+        if (!in_solution[i]) {
+            not_in_solution[not_in_solution_size++] = i;
+        }
+    }
     
     // Safety check: ensure mutation count doesn't exceed a reasonable threshold relative to solution size
     // to prevent the mutation from completely randomizing the solution.
@@ -37,26 +50,25 @@ void mutate_solution(std::vector<int>& solution, int total_nodes, int mutation_c
     }
 
     for (int i = 0; i < mutation_count; ++i) {
-        int randomNum = rand() % 100;
+        int randomNum = random_below(100);
         if (randomNum < 40) {
             // Intra edge exchange
-            int node1 = rand() % solution_size;
-            int node2 = rand() % solution_size;
+            int node1 = random_below(solution_size);
+            int node2 = random_below(solution_size);
             apply_intra_edge_exchange(solution, node1, node2);
         }
         else if (randomNum < 80) {
-            // Inter node exchange
-            std::vector<int> not_in_solution = getNotInSolution(total_nodes, solution);
-            if (!not_in_solution.empty()) {
-                int node_in_solution_pos = rand() % solution_size;
-                int node_not_in_solution_pos = rand() % not_in_solution.size();
-                solution[node_in_solution_pos] = not_in_solution[node_not_in_solution_pos];
+            // Inter node exchange (the removed node takes the inserted node's place outside)
+            if (not_in_solution_size > 0) {
+                int node_in_solution_pos = random_below(solution_size);
+                int node_not_in_solution_pos = random_below(not_in_solution_size);
+                std::swap(solution[node_in_solution_pos], not_in_solution[node_not_in_solution_pos]);
             }
         }
         else {
             // Intra node exchange (swap two nodes in solution)
-            int node1 = rand() % solution_size;
-            int node2 = rand() % solution_size;
+            int node1 = random_below(solution_size);
+            int node2 = random_below(solution_size);
             int tmp = solution[node1];
             solution[node1] = solution[node2];
             solution[node2] = tmp;
@@ -80,7 +92,10 @@ std::vector<int> hybrid_evolutionary_algorithm(const TSPProblem& problem,
                                                bool use_adaptive_mutation,
                                                int stagnation_step,
                                                int k_candidates,
-                                               int max_stagnation_iterations) {
+                                               int max_stagnation_iterations,
+                                               bool use_lin_kernighan,
+                                               bool use_parallel_steepest,
+                                               bool use_multi_move) {
     auto start_time = std::chrono::steady_clock::now();
     iterations = 0;
 
@@ -103,21 +118,37 @@ std::vector<int> hybrid_evolutionary_algorithm(const TSPProblem& problem,
 
     int total_nodes = problem.get_num_points();
 
+    // Buffers and generator for the local search, LNS and mutation, allocated once for the run
+    LocalSearchWorkspace workspace(total_nodes);
+
+    // Extra neighbourhoods of the candidate-move local search (ignored with k_candidates = -1)
+    const bool use_or_opt = true;
+    const bool use_reinsertion = true;
+    const bool use_pair_exchange = total_nodes < PAIR_EXCHANGE_MAX_NODES;
+
+    // Local optimiser applied in place to initial solutions and offspring
+    auto improve = [&](std::vector<int>& solution, SearchType search_type, double* objective) {
+        StageTimer dummy_timer;
+        if (use_lin_kernighan) {
+            solution = lin_kernighan_search(const_cast<TSPProblem&>(problem), solution, search_type, dummy_timer, k_candidates, objective);
+        } else if (use_multi_move && search_type == SearchType::STEEPEST && k_candidates <= 0) {
+            solution = multi_move_local_search(const_cast<TSPProblem&>(problem), std::move(solution), dummy_timer, workspace, objective);
+        } else if (use_parallel_steepest && search_type == SearchType::STEEPEST && k_candidates <= 0) {
+            solution = parallel_steepest_local_search(const_cast<TSPProblem&>(problem), solution, dummy_timer, 0, objective);
+        } else {
+            local_search_in_place(const_cast<TSPProblem&>(problem), solution, search_type, dummy_timer, workspace, k_candidates, objective,
+                                  use_or_opt, use_reinsertion, use_pair_exchange);
+        }
+    };
+
     // Create a lambda that generates random solutions with local search applied
     auto solution_generator = [&]() {
         std::vector<int> constructed_sol = solution_constructor(problem);
         
         // Apply local search to initial random solutions
-        StageTimer dummy_timer;
-        std::vector<int> improved_sol = local_search(
-            const_cast<TSPProblem&>(problem), 
-            constructed_sol, 
-            SearchType::GREEDY, 
-            dummy_timer,
-            k_candidates
-        );
+        improve(constructed_sol, SearchType::GREEDY, nullptr);
         
-        return improved_sol;
+        return constructed_sol;
     };
 
     // Initialize elite population with improved random solutions
@@ -165,6 +196,7 @@ std::vector<int> hybrid_evolutionary_algorithm(const TSPProblem& problem,
         // -------------------------------
 
         std::vector<int> offspring;
+        double offspring_score = UNKNOWN_OBJECTIVE;
         int op_index = -1; // Track which crossover operator was used (-1 if LNS or none)
 
         // Check LNS probability
@@ -196,7 +228,7 @@ std::vector<int> hybrid_evolutionary_algorithm(const TSPProblem& problem,
             // Apply mutation based on probability
             if (chance_out_of_100(gen) < mutation_probability * 100) {
                 // Pass the DETERMINED strength (dynamic or fixed)
-                mutate_solution(offspring, total_nodes, current_mutation_strength);
+                mutate_solution(offspring, total_nodes, workspace, current_mutation_strength);
             }
 
             // Randomly choose local search type
@@ -211,24 +243,19 @@ std::vector<int> hybrid_evolutionary_algorithm(const TSPProblem& problem,
                 search_type = SearchType::GREEDY;
             }
 
-            StageTimer dummy_timer;
-            offspring = local_search(
-                const_cast<TSPProblem&>(problem), 
-                offspring, 
-                search_type, 
-                dummy_timer,
-                k_candidates
-            );
+            improve(offspring, search_type, &offspring_score);
             
         }
         else {
             // Perform large neighborhood search
             std::pair<std::vector<int>, std::vector<int>> parents = population.get_parents();
-            offspring = large_neighborhood_search(const_cast<TSPProblem&>(problem), parents.first, 2, true);
+            offspring = large_neighborhood_search(const_cast<TSPProblem&>(problem), parents.first, 2, true, k_candidates, &offspring_score, &workspace,
+                                                  use_reinsertion);
         }
 
         // Try to add offspring to elite population and capture success status
-        bool added_to_population = population.try_add_solution(offspring);
+        // (the search already tracked its objective, so it is not re-evaluated here)
+        bool added_to_population = population.try_add_solution(offspring, offspring_score);
 
         // Adaptive Probability Update Logic
         if (use_adaptive_crossover && op_index != -1) {
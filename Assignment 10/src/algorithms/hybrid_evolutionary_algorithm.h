@@ -25,6 +25,11 @@ using SolutionConstructor = std::function<std::vector<int>(const TSPProblem&)>;
  * @param population_size Size of the elite population
  * @param iterations Output parameter for number of iterations performed
  * @param crossovers List of crossover operators and their probabilities. If empty, defaults to 50/50 mix of recombination and preservation.
+ * @param use_lin_kernighan Improve solutions with lin_kernighan_search instead of local_search.
+ * @param use_parallel_steepest Run steepest full-neighbourhood searches (k_candidates = -1) with
+ * parallel_steepest_local_search on every hardware thread (same neighbourhood, ties broken by move index).
+ * @param use_multi_move Run steepest full-neighbourhood searches with multi_move_local_search, which applies
+ * batches of non-conflicting improving moves per pass. Takes precedence over use_parallel_steepest.
  * @return The best solution found
  */
 std::vector<int> hybrid_evolutionary_algorithm(const TSPProblem& problem, 
@@ -44,6 +49,9 @@ std::vector<int> hybrid_evolutionary_algorithm(const TSPProblem& problem,
                                                bool use_adaptive_mutation = false,
                                                int stagnation_step = 20,
                                                int k_candidates = -1,
-                                               int max_stagnation_iterations = 1000);
+                                               int max_stagnation_iterations = 1000,
+                                               bool use_lin_kernighan = false,
+                                               bool use_parallel_steepest = false,
+                                               bool use_multi_move = false);
 
 #endif // HYBRID_EVOLUTIONARY_ALGORITHM_H
\ No newline at end of file
@@ -2,8 +2,15 @@
 
 #include <vector>
 #include <math.h>
+#include <algorithm>
+#include <climits>
 #include "../core/point_data.h"
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define INTER_EXCHANGE_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
 double inter_node_exchange(
     TSPProblem& problem_instance,
     std::vector<int>& solution,
@@ -24,11 +31,144 @@ double inter_node_exchange(
 
     current_cost = problem_instance.get_distance(before_node_1, node_1) + 
                    problem_instance.get_distance(node_1, after_node_1) + 
-                   problem_instance.get_point(node_1).cost;
+                   problem_instance.get_cost(node_1);
     cost_after_exchange = problem_instance.get_distance(before_node_1, node_2_id) + 
                           problem_instance.get_distance(node_2_id, after_node_1) + 
-                          problem_instance.get_point(node_2_id).cost;
+                          problem_instance.get_cost(node_2_id);
 
     delta = cost_after_exchange - current_cost;
     return delta;
-};
\ No newline at end of file
+};
+
+// Start of anonymous namespace
+// Functions inside here are local to this file only and are not exported.
+namespace {
+
+typedef int (*InterScanKernel)(const int* row_before, const int* row_after, const int* masked_costs, int n, int& best_node);
+
+int best_inter_exchange_scalar(const int* row_before, const int* row_after, const int* masked_costs, int n, int& best_node) {
+    int best_value = INT_MAX;
+    best_node = -1;
+    for (int x = 0; x < n; ++x) {
+        const int value = row_before[x] + row_after[x] + masked_costs[x];
+        if (value < best_value) {
+            best_value = value;
+            best_node = x;
+        }
+    }
+    if (best_value >= INTER_EXCLUDED_COST) best_node = -1;
+    return best_value;
+}
+
+#ifdef INTER_EXCHANGE_X86_SIMD
+
+__attribute__((target("avx2")))
+int best_inter_exchange_avx2(const int* row_before, const int* row_after, const int* masked_costs, int n, int& best_node) {
+    // Per-lane minimum and the first index reaching it
+    __m256i best_values = _mm256_set1_epi32(INT_MAX);
+    __m256i best_indices = _mm256_set1_epi32(-1);
+    __m256i indices = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i step = _mm256_set1_epi32(8);
+    int x = 0;
+    for (; x + 8 <= n; x += 8) {
+        __m256i value = _mm256_add_epi32(
+            _mm256_add_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(row_before + x)),
+                             _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row_after + x))),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(masked_costs + x)));
+        __m256i better = _mm256_cmpgt_epi32(best_values, value);
+        best_values = _mm256_blendv_epi8(best_values, value, better);
+        best_indices = _mm256_blendv_epi8(best_indices, indices, better);
+        indices = _mm256_add_epi32(indices, step);
+    }
+
+    alignas(32) int lane_values[8];
+    alignas(32) int lane_indices[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lane_values), best_values);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lane_indices), best_indices);
+    int best_value = INT_MAX;
+    best_node = -1;
+    for (int lane = 0; lane < 8; ++lane) {
+        if (lane_values[lane] < best_value || (lane_values[lane] == best_value && lane_indices[lane] < best_node)) {
+            best_value = lane_values[lane];
+            best_node = lane_indices[lane];
+        }
+    }
+    for (; x < n; ++x) {
+        const int value = row_before[x] + row_after[x] + masked_costs[x];
+        if (value < best_value) {
+            best_value = value;
+            best_node = x;
+        }
+    }
+    if (best_value >= INTER_EXCLUDED_COST) best_node = -1;
+    return best_value;
+}
+
+#endif // INTER_EXCHANGE_X86_SIMD
+
+InterScanKernel select_inter_scan_kernel() {
+#ifdef INTER_EXCHANGE_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return best_inter_exchange_avx2;
+#endif
+    return best_inter_exchange_scalar;
+}
+
+}
+
+int best_inter_exchange(
+    const int* row_before,
+    const int* row_after,
+    const int* masked_costs,
+    int n,
+    int& best_node
+) {
+    static const InterScanKernel kernel = select_inter_scan_kernel();
+    return kernel(row_before, row_after, masked_costs, n, best_node);
+}
+
+bool best_inter_exchange_sorted(
+    const CandidateLists& sorted_rows,
+    const int* costs,
+    int before,
+    int after,
+    const int* row_before,
+    const int* row_after,
+    const int* masked_costs,
+    int n,
+    int& best_node,
+    int& best_value
+) {
+    const int* nodes_before = sorted_rows.of(before);
+    const int* distances_before = sorted_rows.distances_of(before);
+    const int* nodes_after = sorted_rows.of(after);
+    const int* distances_after = sorted_rows.distances_of(after);
+
+    best_value = INT_MAX;
+    best_node = -1;
+    auto evaluate = [&](int x) {
+        const int value = row_before[x] + row_after[x] + masked_costs[x];
+        if (value < best_value || (value == best_value && x < best_node)) {
+            best_value = value;
+            best_node = x;
+        }
+    };
+
+    for (int depth = 0; depth < sorted_rows.k; ++depth) {
+        const int x_before = nodes_before[depth];
+        const int x_after = nodes_after[depth];
+        evaluate(x_before);
+        evaluate(x_after);
+
+        // Every node not met yet has an insertion value of at least the larger key at this depth
+        const int bound = std::max(distances_before[depth] + costs[x_before], distances_after[depth] + costs[x_after]);
+        if (bound > best_value) {
+            if (best_value >= INTER_EXCLUDED_COST) best_node = -1;
+            return true;
+        }
+    }
+    // Rows holding every other node leave nothing unseen; shorter ones may hide a better node
+    if (sorted_rows.k < n - 1) return false;
+    if (best_value >= INTER_EXCLUDED_COST) best_node = -1;
+    return true;
+}
@@ -5,6 +5,7 @@
 #include <math.h>
 #include "../core/point_data.h"
 #include "../core/TSPProblem.h"
+#include "../core/candidate_lists.h"
 
 /**
  * @brief Calculates the change in total cost (delta) for an inter-route node exchange.
@@ -26,4 +27,70 @@ double inter_node_exchange(
     int node_2_id
 );
 
+/// Masked cost of a node that is already in the solution; large enough that it never wins a
+/// best_inter_exchange scan, small enough that two distances can be added without overflow.
+const int INTER_EXCLUDED_COST = 1 << 29;
+
+/**
+ * @brief Finds the best node to insert between `before` and `after` in one vectorized pass.
+ *
+ * Computes row_before[x] + row_after[x] + masked_costs[x] for every node x in [0, n) and
+ * returns the minimum. masked_costs[x] is the node cost for nodes outside the solution and
+ * INTER_EXCLUDED_COST for nodes in it, so the rows and the cost array are read contiguously
+ * with no gather. The inter delta for the node at that position is the returned value minus
+ * d(before, node) + d(node, after) + cost(node). Uses AVX2 when the CPU supports it.
+ *
+ * @param row_before Distance matrix row of the node before the position.
+ * @param row_after Distance matrix row of the node after the position.
+ * @param masked_costs Node costs with the nodes in the solution set to INTER_EXCLUDED_COST.
+ * @param n Number of nodes.
+ * @param best_node Output: the lowest-id node reaching the minimum, or -1 if every node is excluded.
+ * @return The minimum insertion value (meaningless if best_node is -1).
+ */
+int best_inter_exchange(
+    const int* row_before,
+    const int* row_after,
+    const int* masked_costs,
+    int n,
+    int& best_node
+);
+
+/**
+ * @brief Same result as best_inter_exchange, found by walking two sorted rows until a bound stops it.
+ *
+ * `sorted_rows` holds candidate lists (problem.get_candidates(K)): every node's K best other
+ * nodes x sorted by d(node, x) + cost(x). The walk visits the rows of `before` and `after` in
+ * lockstep and evaluates every outside node it meets exactly. After depth i, a node met in
+ * neither row has d(before, x) + cost(x) and d(after, x) + cost(x) at least the keys at depth i,
+ * so its insertion value is at least the larger of the two. The walk stops once that bound
+ * exceeds the best value found, so the lowest-id minimum is exact, like a full scan. When
+ * `before` and `after` are close, the best node is near both and the walk stays shallow. When
+ * they are far apart it can run off the end of lists shorter than n - 1, and the caller falls
+ * back to best_inter_exchange; short lists therefore bound both the walk and its memory.
+ *
+ * @param sorted_rows Candidate lists of the problem.
+ * @param costs Node costs, indexed by node id.
+ * @param before Node before the position.
+ * @param after Node after the position.
+ * @param row_before Distance matrix row of `before`.
+ * @param row_after Distance matrix row of `after`.
+ * @param masked_costs Node costs with the nodes in the solution set to INTER_EXCLUDED_COST.
+ * @param n Number of nodes of the problem.
+ * @param best_node Output: the lowest-id node reaching the minimum, or -1 if every node is excluded.
+ * @param best_value Output: the minimum insertion value (meaningless if best_node is -1).
+ * @return True if the outputs are exact, false if the rows ended before the bound stopped the walk.
+ */
+bool best_inter_exchange_sorted(
+    const CandidateLists& sorted_rows,
+    const int* costs,
+    int before,
+    int after,
+    const int* row_before,
+    const int* row_after,
+    const int* masked_costs,
+    int n,
+    int& best_node,
+    int& best_value
+);
+
 #endif // INTER_NODE_EXCHANGE_H
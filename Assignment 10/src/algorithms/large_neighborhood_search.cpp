@@ -3,13 +3,18 @@
 #include "destroy_operator.h"
 #include "repair_operator.h"
 #include "../core/evaluation.h"
+#include <memory>
 #include <random>
 
 std::vector<int> large_neighborhood_search(
     TSPProblem& problem_instance,
     std::vector<int> starting_solution,
     int iteration_limit,
-    bool use_local_search
+    bool use_local_search,
+    int k_candidates,
+    double* objective,
+    LocalSearchWorkspace* workspace,
+    bool use_reinsertion
 ) {
     
     std::vector<int> current_solution = starting_solution;
@@ -18,26 +23,33 @@ std::vector<int> large_neighborhood_search(
     StageTimer dummy_timer;
     
     std::vector<int> best_solution = current_solution;
-    double best_score = evaluate_solution(best_solution, problem_instance);
+    double best_score = (objective && is_objective_known(*objective))
+        ? *objective : evaluate_solution(best_solution, problem_instance);
     double current_score = best_score;
     
-    std::mt19937 rng(std::random_device{}());
+    std::unique_ptr<LocalSearchWorkspace> own_workspace;
+    if (!workspace) {
+        own_workspace = std::make_unique<LocalSearchWorkspace>(problem_instance.get_num_points());
+        workspace = own_workspace.get();
+    }
+    std::mt19937& rng = workspace->rng;
     
     for (int i = 0; i < iteration_limit; i++) {
         
         // Destroy
         std::vector<int> partial_solution = destroy_solution(current_solution, problem_instance, rng);
         
-        // Repair
-        std::vector<int> repaired_solution = repair_solution(partial_solution, problem_instance);
+        // Repair (the repair and the local search both track the exact objective,
+        // so the repaired solution never needs a full re-evaluation)
+        double repaired_score;
+        std::vector<int> repaired_solution = repair_solution(partial_solution, problem_instance, &repaired_score);
         
         // Optional Local Search
         if (use_local_search) {
-            repaired_solution = local_search(problem_instance, repaired_solution, SearchType::STEEPEST, dummy_timer);
+            local_search_in_place(problem_instance, repaired_solution, SearchType::STEEPEST, dummy_timer, *workspace, k_candidates, &repaired_score,
+                                  false, use_reinsertion);
         }
         
-        double repaired_score = evaluate_solution(repaired_solution, problem_instance);
-        
         // Acceptance criteria: Accept if better than current (Hill Climbing)
         if (repaired_score < current_score) {
             current_solution = repaired_solution;
@@ -50,5 +62,8 @@ std::vector<int> large_neighborhood_search(
         }
     }
     
+    if (objective) {
+        *objective = best_score;
+    }
     return best_solution;
 }
@@ -3,6 +3,7 @@
 
 #include "../core/TSPProblem.h"
 #include "../core/stagetimer.h"
+#include "local_search_workspace.h"
 #include <vector>
 
 /**
@@ -12,13 +13,24 @@
  * @param starting_solution The initial solution.
  * @param iteration_limit Amount of iterations to perform
  * @param use_local_search Whether to apply local search after repair.
+ * @param k_candidates Number of candidate neighbours for the local search (-1 = full neighbourhood).
+ * @param objective Optional in/out objective: the objective of `starting_solution` if known
+ * (UNKNOWN_OBJECTIVE otherwise); on return the exact objective of the best solution.
+ * @param workspace Optional workspace of the calling thread for the local search and the destroy
+ * operator's randomness; without one the call creates its own.
+ * @param use_reinsertion Whether the candidate-move local search includes reinsertion exchanges
+ * (see local_search_in_place).
  * @return The best solution found.
  */
 std::vector<int> large_neighborhood_search(
     TSPProblem& problem_instance,
     std::vector<int> starting_solution,
     int iteration_limit,
-    bool use_local_search
+    bool use_local_search,
+    int k_candidates = -1,
+    double* objective = nullptr,
+    LocalSearchWorkspace* workspace = nullptr,
+    bool use_reinsertion = false
 );
 
 #endif // LARGE_NEIGHBORHOOD_SEARCH_H
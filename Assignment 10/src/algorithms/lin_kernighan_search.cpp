@@ -0,0 +1,331 @@
+#include "lin_kernighan_search.h"
+
+#include <algorithm>
+#include <vector>
+#include "../core/evaluation.h"
+#include "../core/two_level_list.h"
+
+// Start of anonymous namespace
+// Functions inside here are local to this file only and are not exported.
+namespace {
+
+// One applied 2-opt step: edges (a, b) and (c, d) were replaced by (a, c) and (b, d)
+struct TwoOptStep {
+    int a, b, c, d;
+};
+
+// A possible next step of a chain: add (t2, t3), break (t3, t4)
+struct ChainOption {
+    int t3, t4;
+    double lookahead; ///< Running gain after the step, before closing the tour
+};
+
+/**
+ * @brief Set of edges touched by one chain, stored as marks on their end nodes.
+ *
+ * A chain only breaks edges of the tour it started from (breaking an added edge is tabu) and
+ * never breaks an edge it added, so every node ends up in at most two removed and at most two added
+ * edges; two partner slots per node hold either set. Marks carry the chain's stamp, so clearing
+ * the set is O(1).
+ */
+class ChainEdgeSet {
+public:
+    explicit ChainEdgeSet(int num_nodes) : stamp(0), node_stamp(num_nodes, -1), partners(2 * num_nodes) {}
+
+    void clear() { ++stamp; }
+
+    void insert(int u, int v) {
+        insert_half(u, v);
+        insert_half(v, u);
+    }
+
+    bool contains(int u, int v) const {
+        return node_stamp[u] == stamp && (partners[2 * u] == v || partners[2 * u + 1] == v);
+    }
+
+private:
+    void insert_half(int u, int v) {
+        if (node_stamp[u] != stamp) {
+            node_stamp[u] = stamp;
+            partners[2 * u] = v;
+            partners[2 * u + 1] = -1;
+        } else {
+            partners[2 * u + 1] = v;
+        }
+    }
+
+    int stamp;
+    std::vector<int> node_stamp;
+    std::vector<int> partners;
+};
+
+/**
+ * @brief Chain construction and undo on a TwoLevelList tour.
+ */
+class ChainSearch {
+public:
+    ChainSearch(const TSPProblem& problem_instance, TwoLevelList& tour, const CandidateLists& candidates)
+        : problem(problem_instance), tour(tour), candidates(candidates),
+          added_edges(problem_instance.get_num_points()), removed_edges(problem_instance.get_num_points()) {}
+
+    /**
+     * @brief Builds a chain that starts by breaking (t1, t2), using the `first_choice`-th best
+     * option for the first added edge.
+     * @return The closed-tour gain of the kept prefix; 0 if nothing was kept (tour unchanged).
+     */
+    double run_chain(int t1, int t2, int first_choice) {
+        steps.clear();
+        added_edges.clear();
+        removed_edges.clear();
+
+        double gain = problem.get_distance(t1, t2);
+        removed_edges.insert(t1, t2);
+        double best_gain = 0.0;
+        size_t best_length = 0;
+
+        for (int depth = 0; depth < LIN_KERNIGHAN_MAX_DEPTH; ++depth) {
+            collect_options(t1, t2, gain);
+            if (options.empty()) break;
+
+            const ChainOption* chosen;
+            if (depth == 0) {
+                if (first_choice >= static_cast<int>(options.size())) break;
+                std::stable_sort(options.begin(), options.end(),
+                                 [](const ChainOption& x, const ChainOption& y) { return x.lookahead > y.lookahead; });
+                chosen = &options[first_choice];
+            } else {
+                chosen = &*std::max_element(options.begin(), options.end(),
+                                            [](const ChainOption& x, const ChainOption& y) { return x.lookahead < y.lookahead; });
+            }
+            const int t3 = chosen->t3;
+            const int t4 = chosen->t4;
+            gain = chosen->lookahead;
+
+            // Keep the orientation straight: the step must break (t1, t2) and (t3, t4)
+            TwoOptStep step = (tour.next(t1) == t2) ? TwoOptStep{t1, t2, t4, t3} : TwoOptStep{t2, t1, t3, t4};
+            tour.two_opt_move(step.a, step.b, step.c, step.d);
+            steps.push_back(step);
+            added_edges.insert(t2, t3);
+            removed_edges.insert(t3, t4);
+
+            // The step closed the tour with (t1, t4); that edge is what the next step breaks
+            const double closed_gain = gain - problem.get_distance(t4, t1);
+            if (closed_gain > best_gain) {
+                best_gain = closed_gain;
+                best_length = steps.size();
+            }
+            t2 = t4;
+        }
+
+        undo_steps(best_length);
+        return best_gain;
+    }
+
+    /// Undoes the applied steps until only the first `length` remain.
+    void undo_steps(size_t length) {
+        while (steps.size() > length) {
+            const TwoOptStep& step = steps.back();
+            if (tour.next(step.a) == step.c) {
+                tour.two_opt_move(step.a, step.c, step.b, step.d);
+            } else {
+                tour.two_opt_move(step.c, step.a, step.d, step.b);
+            }
+            steps.pop_back();
+        }
+    }
+
+    /// Steps of the last chain that are still applied.
+    const std::vector<TwoOptStep>& kept_steps() const { return steps; }
+
+private:
+    void collect_options(int t1, int t2, double gain) {
+        options.clear();
+        const bool forward = (tour.next(t1) == t2);
+        const int* t2_candidates = candidates.of(t2);
+        for (int c = 0; c < candidates.k; ++c) {
+            const int t3 = t2_candidates[c];
+            if (!tour.contains(t3) || t3 == t1) continue;
+
+            // Gain criterion: the partial sum must stay positive after adding (t2, t3)
+            const double open_gain = gain - problem.get_distance(t2, t3);
+            if (open_gain <= 0) continue;
+
+            // Breaking (t3, t4) on this side keeps the tour closable with (t1, t4)
+            const int t4 = forward ? tour.prev(t3) : tour.next(t3);
+            if (t4 == t2 || t4 == t1) continue;
+
+            if (removed_edges.contains(t2, t3) || added_edges.contains(t3, t4)) continue;
+
+            options.push_back({t3, t4, open_gain + problem.get_distance(t3, t4)});
+        }
+    }
+
+    const TSPProblem& problem;
+    TwoLevelList& tour;
+    const CandidateLists& candidates;
+
+    std::vector<TwoOptStep> steps;
+    ChainEdgeSet added_edges;
+    ChainEdgeSet removed_edges;
+    std::vector<ChainOption> options;
+};
+
+}
+
+std::vector<int> lin_kernighan_search(TSPProblem& problem_instance,
+                                      std::vector<int> starting_solution,
+                                      SearchType T, StageTimer& timer,
+                                      int k_candidates,
+                                      double* objective) {
+    const int solution_size = starting_solution.size();
+    if (k_candidates <= 0) {
+        k_candidates = LIN_KERNIGHAN_DEFAULT_CANDIDATES;
+    }
+    // Chains need room for several disjoint edges
+    if (solution_size < 8) {
+        return local_search(problem_instance, starting_solution, T, timer, k_candidates, objective);
+    }
+
+    double current_objective = 0.0;
+    if (objective) {
+        current_objective = is_objective_known(*objective) ? *objective : evaluate_solution(starting_solution, problem_instance);
+    }
+
+    timer.start_stage("local search");
+
+    const int data_size = problem_instance.get_num_points();
+    const CandidateLists& candidates = problem_instance.get_candidates(k_candidates);
+    TwoLevelList tour(starting_solution, data_size);
+    ChainSearch chain_search(problem_instance, tour, candidates);
+
+    // Don't-look bits: FIFO of base nodes that may still start an improving step
+    std::vector<int> active_queue(data_size);
+    std::vector<char> in_queue(data_size, 0);
+    int queue_head = 0, queue_size = 0;
+    auto activate = [&](int node) {
+        if (tour.contains(node) && !in_queue[node]) {
+            in_queue[node] = 1;
+            active_queue[(queue_head + queue_size) % data_size] = node;
+            queue_size++;
+        }
+    };
+    auto activate_around = [&](int node) {
+        if (tour.contains(node)) {
+            activate(tour.prev(node));
+            activate(node);
+            activate(tour.next(node));
+        }
+    };
+    for (int node : starting_solution) {
+        activate(node);
+    }
+
+    const double epsilon = 1e-9;
+    // The result starts where the input started, or at the node that replaced it
+    int anchor = starting_solution[0];
+
+    while (queue_size > 0) {
+        const int t1 = active_queue[queue_head];
+        queue_head = (queue_head + 1) % data_size;
+        queue_size--;
+        in_queue[t1] = 0;
+        if (!tour.contains(t1)) continue;
+
+        // --- Selection step: swap a tour neighbour of t1 for an unused candidate of t1 ---
+        {
+            const int pred1 = tour.prev(t1);
+            const int succ1 = tour.next(t1);
+            double best_delta = 0.0;
+            int best_removed = -1, best_added = -1;
+            const int* t1_candidates = candidates.of(t1);
+            for (int c = 0; c < candidates.k; ++c) {
+                const int node2 = t1_candidates[c];
+                if (tour.contains(node2)) continue;
+
+                const int before = tour.prev(pred1);
+                double delta = problem_instance.get_distance(before, node2) + problem_instance.get_distance(node2, t1) + problem_instance.get_cost(node2)
+                             - problem_instance.get_distance(before, pred1) - problem_instance.get_distance(pred1, t1) - problem_instance.get_cost(pred1);
+                if (delta < best_delta - epsilon) {
+                    best_delta = delta;
+                    best_removed = pred1;
+                    best_added = node2;
+                    if (T == SearchType::GREEDY) break;
+                }
+
+                const int after = tour.next(succ1);
+                delta = problem_instance.get_distance(t1, node2) + problem_instance.get_distance(node2, after) + problem_instance.get_cost(node2)
+                      - problem_instance.get_distance(t1, succ1) - problem_instance.get_distance(succ1, after) - problem_instance.get_cost(succ1);
+                if (delta < best_delta - epsilon) {
+                    best_delta = delta;
+                    best_removed = succ1;
+                    best_added = node2;
+                    if (T == SearchType::GREEDY) break;
+                }
+            }
+
+            if (best_removed != -1) {
+                tour.replace(best_removed, best_added);
+                if (best_removed == anchor) anchor = best_added;
+                current_objective += best_delta;
+                activate(t1);
+                activate_around(best_added);
+                // The freed node may now be worth inserting next to the nodes listing it
+                const int* listing = candidates.listed_by_of(best_removed);
+                for (int c = 0; c < candidates.listed_by_count(best_removed); ++c) {
+                    activate(listing[c]);
+                }
+                continue;
+            }
+        }
+
+        // --- Edge-exchange chains from t1, in both tour directions ---
+        double best_gain = 0.0;
+        int best_t2 = -1, best_choice = -1;
+        bool chain_applied = false; // Greedy search keeps the first improving chain applied
+        const int neighbours[2] = {tour.next(t1), tour.prev(t1)};
+        for (int side = 0; side < 2 && !chain_applied; ++side) {
+            const int t2 = neighbours[side];
+            for (int choice = 0; choice < LIN_KERNIGHAN_FIRST_LEVEL_BREADTH; ++choice) {
+                const double gain = chain_search.run_chain(t1, t2, choice);
+                if (gain <= epsilon) continue;
+                if (T == SearchType::GREEDY) {
+                    best_gain = gain;
+                    best_t2 = t2;
+                    chain_applied = true;
+                    break;
+                }
+                if (gain > best_gain) {
+                    best_gain = gain;
+                    best_t2 = t2;
+                    best_choice = choice;
+                }
+                chain_search.undo_steps(0);
+            }
+        }
+        if (best_t2 != -1 && !chain_applied) {
+            // Rebuilding the chain on the same tour is deterministic
+            best_gain = chain_search.run_chain(t1, best_t2, best_choice);
+        }
+
+        if (best_t2 != -1) {
+            current_objective -= best_gain;
+            activate(t1);
+            for (const TwoOptStep& step : chain_search.kept_steps()) {
+                activate_around(step.a);
+                activate_around(step.b);
+                activate_around(step.c);
+                activate_around(step.d);
+            }
+        }
+    }
+
+    timer.end_stage();
+
+    std::vector<int> solution = tour.to_vector(anchor);
+
+    if (objective) {
+        check_objective(solution, problem_instance, current_objective, "lin_kernighan_search");
+        *objective = current_objective;
+    }
+    return solution;
+}
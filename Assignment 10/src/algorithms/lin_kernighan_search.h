@@ -0,0 +1,49 @@
+#ifndef LIN_KERNIGHAN_SEARCH_H
+#define LIN_KERNIGHAN_SEARCH_H
+
+#include <vector>
+#include "local_search.h"
+#include "../core/TSPProblem.h"
+#include "../core/stagetimer.h"
+
+/// Maximum number of 2-opt steps in one edge-exchange chain.
+const int LIN_KERNIGHAN_MAX_DEPTH = 8;
+
+/// Number of alternatives tried for the first added edge of a chain.
+const int LIN_KERNIGHAN_FIRST_LEVEL_BREADTH = 3;
+
+/// Candidate list size used when the caller does not request one (k_candidates <= 0).
+const int LIN_KERNIGHAN_DEFAULT_CANDIDATES = 10;
+
+/**
+ * @brief Variable-depth (Lin-Kernighan style) local search.
+ *
+ * From a base node t1 the tour edge (t1, t2) is broken and a chain of sequential 2-opt steps is
+ * built over the candidate lists: each step adds an edge (t2, t3) to a candidate t3, breaks the
+ * tour edge (t3, t4) that keeps the tour closable, and continues from t4. A step is taken only
+ * while the running gain stays positive, edges added in the chain are never broken again and
+ * broken edges are never re-added (tabu). The chain keeps the prefix with the best closed-tour
+ * gain, and the rest is undone. Chains run on a TwoLevelList, so every step costs O(sqrt(n)).
+ *
+ * The selection part of the problem is handled by node exchange steps: the predecessor or
+ * successor of t1 is replaced by an unused candidate of t1 when that improves the objective.
+ * Base nodes are processed from a don't-look-bit queue, and the search stops when it is empty.
+ *
+ * It takes the same arguments as local_search and can replace it in the HEA.
+ *
+ * @param problem_instance The TSPProblem instance.
+ * @param starting_solution The solution to improve.
+ * @param T GREEDY applies the first improving chain; STEEPEST tries every first-level alternative
+ * (LIN_KERNIGHAN_FIRST_LEVEL_BREADTH per direction) and applies the best one.
+ * @param timer StageTimer recording the "local search" stage.
+ * @param k_candidates Number of candidate neighbours per node (LIN_KERNIGHAN_DEFAULT_CANDIDATES if <= 0).
+ * @param objective Optional in/out objective, as in local_search.
+ * @return The locally optimal solution (its traversal direction may differ from the input).
+ */
+std::vector<int> lin_kernighan_search(TSPProblem& problem_instance,
+                                      std::vector<int> starting_solution,
+                                      SearchType T, StageTimer& timer,
+                                      int k_candidates = -1,
+                                      double* objective = nullptr);
+
+#endif // LIN_KERNIGHAN_SEARCH_H
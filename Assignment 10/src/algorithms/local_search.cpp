@@ -7,45 +7,13 @@
 #include <limits>
 #include <cstring>
 #include "../core/stagetimer.h"
+#include "../core/evaluation.h"
 #include "inter_node_exchange.h"
 #include "intra_edge_exchange.h"
+#include "or_opt.h"
+#include "neighborhood_utils.h"
 #include <iostream>
 
-/**
- * @brief Helper to precompute candidate neighbors using TSPProblem interface.
- */
-std::vector<std::vector<int>> precompute_candidates_internal(
-    TSPProblem& problem,
-    int K
-) {
-    int n = problem.get_num_points();
-    std::vector<std::vector<int>> candidate_neighbors(n);
-    
-    for (int i = 0; i < n; ++i) {
-        std::vector<std::pair<int, int>> neighbors;
-        neighbors.reserve(n - 1);
-        
-        for (int j = 0; j < n; ++j) {
-            if (i != j) {
-                // Cost metric: distance + cost of the target node
-                int cost = problem.get_distance(i, j) + problem.get_point(j).cost;
-                neighbors.push_back({cost, j});
-            }
-        }
-        
-        // Sort by cost (ascending)
-        std::sort(neighbors.begin(), neighbors.end());
-        
-        // Take the K nearest
-        int actual_k = std::min(K, (int)neighbors.size());
-        candidate_neighbors[i].reserve(actual_k);
-        for (int k = 0; k < actual_k; ++k) {
-            candidate_neighbors[i].push_back(neighbors[k].second);
-        }
-    }
-    return candidate_neighbors;
-}
-
 /**
  * @brief Applies a given move to the solution.
  */
@@ -66,32 +34,64 @@ inline void apply_change(
     }
 }
 
-std::vector<int> local_search(
+// Start of anonymous namespace
+// Functions inside here are local to this file only and are not exported.
+namespace {
+
+// Best replacement cache entry whose tour neighbours changed or whose best node was taken
+const int INTER_CACHE_STALE = -2;
+
+// Instance size from which stale cache entries are recomputed by walking sorted candidate lists
+// first; below it the vectorized row scan is faster than the walk
+const int SORTED_EXCHANGE_MIN_NODES = 2000;
+// The walked lists hold this fraction of every row (n / 16 candidates, about 3 / 16 of the
+// matrix in memory); a walk that runs off their end falls back to the row scan
+const int SORTED_EXCHANGE_DEPTH_DIVISOR = 16;
+
+/**
+ * @brief The local search, specialised at compile time.
+ *
+ * T selects steepest or first-improvement, UseCandidates the candidate-move or the full
+ * neighbourhood, UseOrOpt whether candidate moves include Or-opt relocations,
+ * UseReinsertion whether they include exchanges that reinsert the new node elsewhere and
+ * UsePairExchange whether they include exchanges of two consecutive nodes. Each
+ * instantiation only contains the branches and move evaluations it can reach.
+ */
+template <SearchType T, bool UseCandidates, bool UseOrOpt, bool UseReinsertion, bool UsePairExchange>
+void local_search_kernel(
     TSPProblem& problem_instance,
-    std::vector<int> starting_solution,
-    SearchType T,
+    std::vector<int>& solution,
     StageTimer& timer,
-    int k_candidates
+    LocalSearchWorkspace& workspace,
+    int k_candidates,
+    double* objective
 ) {
-    const bool use_candidate_moves = (k_candidates > 0);
-    std::vector<int> solution = starting_solution;
+    static_assert(UseCandidates || (!UseOrOpt && !UseReinsertion && !UsePairExchange),
+                  "Or-opt, reinsertion and pair exchange moves are only generated from candidate lists");
+    constexpr bool use_candidate_moves = UseCandidates;
+
+    // Objective of the current solution, kept up to date with every applied delta
+    double current_objective = 0.0;
+    if (objective) {
+        current_objective = is_objective_known(*objective) ? *objective : evaluate_solution(solution, problem_instance);
+    }
 
     timer.start_stage("local search");
     
     // --- MEMORY ALLOCATION & INITIALIZATION ---
-    // Use fixed arrays instead of vectors for efficiency
+    // Fixed arrays borrowed from the workspace, which allocates them once per problem
     const int solution_size = solution.size();
     const int data_size = problem_instance.get_num_points();
     const int not_in_solution_size = data_size - solution_size;
+    workspace.reserve(data_size);
     
-    int* not_in_solution = new int[not_in_solution_size];
-    int* solution_pos = new int[solution_size]; // Used for shuffling order
+    int* not_in_solution = workspace.not_in_solution.data();
     
     // Lookup arrays for O(1) checks (Crucial for Candidate Moves efficiency)
     // - node_to_sol_pos[node_id] = position in solution (0..N-1) or -1 if not in solution
     // - node_to_not_in_pos[node_id] = index in not_in_solution array (0..M-1) or -1
-    int* node_to_sol_pos = new int[data_size];
-    int* node_to_not_in_pos = new int[data_size];
+    int* node_to_sol_pos = workspace.node_to_sol_pos.data();
+    int* node_to_not_in_pos = workspace.node_to_not_in_pos.data();
 
     // Initialize Lookups
     std::fill(node_to_sol_pos, node_to_sol_pos + data_size, -1);
@@ -100,7 +100,6 @@ std::vector<int> local_search(
     // Initialize Lookups based on starting solution
     for (int i = 0; i < solution_size; ++i) {
         node_to_sol_pos[solution[i]] = i;
-        solution_pos[i] = i;
     }
 
     // Build not_in_solution array and lookups
@@ -113,25 +112,95 @@ std::vector<int> local_search(
         }
     }
 
-    // Precompute candidates if requested
-    std::vector<std::vector<int>> candidate_neighbors;
+    // Candidate lists are built once per problem and K, then shared by every call
+    const CandidateLists* candidate_neighbors = nullptr;
     if (use_candidate_moves) {
-        timer.end_stage();
-        timer.start_stage("precompute candidates");
-        candidate_neighbors = precompute_candidates_internal(problem_instance, k_candidates);
-        timer.end_stage();
-        timer.start_stage("local search");
+        candidate_neighbors = &problem_instance.get_candidates(k_candidates);
+    }
+
+    // Pair exchange bound: no node y reaches an unused node z for less than
+    // d(y, z) + cost(z) >= nearest_key(y) >= min_nearest_key
+    auto nearest_key = [&](int node) {
+        return candidate_neighbors->distances_of(node)[0] + problem_instance.get_cost(candidate_neighbors->of(node)[0]);
+    };
+    int min_nearest_key = 0;
+    if constexpr (UsePairExchange) {
+        min_nearest_key = std::numeric_limits<int>::max();
+        for (int i = 0; i < data_size; ++i) {
+            min_nearest_key = std::min(min_nearest_key, nearest_key(i));
+        }
+    }
+
+    // Don't-look bits for candidate moves: a FIFO of nodes whose neighbourhood may hold an
+    // improving move. Every node starts active; after a move only the nodes on changed edges
+    // (and the node swapped in) are re-activated, and the search ends once the queue is empty.
+    int* active_queue = nullptr;
+    char* in_queue = nullptr;
+    int queue_head = 0, queue_size = 0;
+    auto activate = [&](int node) {
+        if (!in_queue[node]) {
+            in_queue[node] = 1;
+            active_queue[(queue_head + queue_size) % data_size] = node;
+            queue_size++;
+        }
+    };
+    if constexpr (use_candidate_moves) {
+        active_queue = workspace.active_queue.data();
+        in_queue = workspace.in_queue.data();
+        std::fill(in_queue, in_queue + data_size, 0);
+        for (int i = 0; i < solution_size; ++i) {
+            activate(solution[i]);
+        }
+    }
+
+    // Steepest full-neighbourhood search scans the inter moves of a position with one vectorized
+    // pass over the matrix rows of its neighbours; masked_costs keeps nodes in the solution out
+    const bool scan_inter_rows = !use_candidate_moves && T == SearchType::STEEPEST
+                                 && problem_instance.has_distance_matrix();
+    int* masked_costs = nullptr;
+    if (scan_inter_rows) {
+        masked_costs = workspace.masked_costs.data();
+        for (int i = 0; i < data_size; ++i) {
+            masked_costs[i] = (node_to_sol_pos[i] == -1) ? problem_instance.get_cost(i) : INTER_EXCLUDED_COST;
+        }
     }
 
-    auto rng = std::default_random_engine {};
-    std::random_device rd;
-    rng.seed(rd());
+    // Best replacement cache for the row scan, indexed by tour node: the outside node with the
+    // lowest insertion value between the node's current tour neighbours (lowest id on ties, -1 if
+    // none) and that value. A move marks stale only the entries whose neighbours changed or whose
+    // best node it took, and offers the node it removed to the others, so a pass rescans O(1) rows.
+    int* inter_best_node = nullptr;
+    int* inter_best_value = nullptr;
+    if (scan_inter_rows) {
+        inter_best_node = workspace.inter_best_node.data();
+        inter_best_value = workspace.inter_best_value.data();
+        std::fill(inter_best_node, inter_best_node + data_size, INTER_CACHE_STALE);
+    }
+
+    // On large instances the best replacement between two close neighbours is close to both, so
+    // a walk down their sorted candidate lists (see best_inter_exchange_sorted) usually ends
+    // long before a scan of the whole rows would
+    const CandidateLists* sorted_rows = nullptr;
+    const int* node_costs = nullptr;
+    if (scan_inter_rows && data_size >= SORTED_EXCHANGE_MIN_NODES) {
+        sorted_rows = &problem_instance.get_candidates(data_size / SORTED_EXCHANGE_DEPTH_DIVISOR);
+        node_costs = problem_instance.get_costs().data();
+    }
+
+    // Nodes touched by the last applied move (at most an Or-opt segment plus four edge ends)
+    int changed_nodes[OR_OPT_MAX_SEGMENT_LENGTH + 4];
+    int num_changed_nodes = 0;
+
+    std::mt19937& rng = workspace.rng;
     
     const double epsilon = 1e-9;
     
     // Limits for the efficient iterator-based approach
-    const int inter_limit = solution_size * not_in_solution_size;
-    const int intra_limit = (solution_size < 2) ? 0 : (solution_size * (solution_size - 1) / 2);
+    const long long inter_limit = static_cast<long long>(solution_size) * not_in_solution_size;
+    const long long intra_limit = (solution_size < 2) ? 0 : (static_cast<long long>(solution_size) * (solution_size - 1) / 2);
+
+    // Random visiting order of the full neighbourhood, redrawn in O(1) for every pass
+    StridePermutation inter_order, intra_order;
 
     // --- MAIN OPTIMIZATION LOOP ---
     while (true) {
@@ -139,21 +208,45 @@ std::vector<int> local_search(
         
         int best_pos1 = -1, best_pos2_or_id = -1, best_pos_in_not_used = -1;
         NeighbourhoodType best_intra_or_inter = NeighbourhoodType::INTRA;
-        bool improving_move_found_greedy = false;
+        int active_node = -1;
+        int best_segment_length = 0;
+        bool best_segment_reversed = false;
+        int best_target_pos = -1; // Reinsertion: the new node goes after this position
+        int best_second_node = -1; // Pair exchange: the node entering at best_pos1 + 1
 
         // ============================================================
         // BRANCH: CANDIDATE MOVES LOGIC
         // ============================================================
-        if (use_candidate_moves) {
+        if constexpr (use_candidate_moves) {
             // Logic adapted from local_search_candidate.cpp but using O(1) array lookups
-            // Iterates over nodes in solution -> their candidate neighbors
+            // Pops active nodes (don't-look bits off) and scans their candidate neighbors
+            // until one of them has an improving move
             
-            for (int pos1 = 0; pos1 < solution_size; ++pos1) {
-                int node1 = solution[pos1];
+            while (queue_size > 0) {
+                int node1 = active_queue[queue_head];
+                queue_head = (queue_head + 1) % data_size;
+                queue_size--;
+                in_queue[node1] = 0;
+
+                int pos1 = node_to_sol_pos[node1];
+                if (pos1 == -1) continue; // Swapped out since it was queued
+                active_node = node1;
+
                 int pos1_prev = (pos1 - 1 + solution_size) % solution_size;
                 int pos1_next = (pos1 + 1) % solution_size;
 
-                for (int node2 : candidate_neighbors[node1]) {
+                // Reinsertion: change in cost from removing node1 (its neighbours get joined)
+                double node1_removal_delta = 0.0;
+                if constexpr (UseReinsertion) {
+                    const int pred1 = solution[pos1_prev];
+                    const int succ1 = solution[pos1_next];
+                    node1_removal_delta = problem_instance.get_distance(pred1, succ1) - problem_instance.get_distance(pred1, node1)
+                                        - problem_instance.get_distance(node1, succ1) - problem_instance.get_cost(node1);
+                }
+
+                const int* node1_candidates = candidate_neighbors->of(node1);
+                for (int c = 0; c < candidate_neighbors->k; ++c) {
+                    int node2 = node1_candidates[c];
                     
                     // CHECK 1: Node2 is NOT in solution -> Try INTER exchange
                     if (node_to_sol_pos[node2] == -1) {
@@ -167,8 +260,8 @@ std::vector<int> local_search(
                             int after = solution[(p_prev + 1) % solution_size]; // which is node1
                             int removed = solution[p_prev];
 
-                            double delta = problem_instance.get_distance(before, node2) + problem_instance.get_distance(node2, after) + problem_instance.get_point(node2).cost
-                                         - problem_instance.get_distance(before, removed) - problem_instance.get_distance(removed, after) - problem_instance.get_point(removed).cost;
+                            double delta = problem_instance.get_distance(before, node2) + problem_instance.get_distance(node2, after) + problem_instance.get_cost(node2)
+                                         - problem_instance.get_distance(before, removed) - problem_instance.get_distance(removed, after) - problem_instance.get_cost(removed);
 
                             if (delta < best_delta) {
                                 best_delta = delta;
@@ -187,8 +280,8 @@ std::vector<int> local_search(
                             int after = solution[(p_next + 1) % solution_size];
                             int removed = solution[p_next];
 
-                            double delta = problem_instance.get_distance(before, node2) + problem_instance.get_distance(node2, after) + problem_instance.get_point(node2).cost
-                                         - problem_instance.get_distance(before, removed) - problem_instance.get_distance(removed, after) - problem_instance.get_point(removed).cost;
+                            double delta = problem_instance.get_distance(before, node2) + problem_instance.get_distance(node2, after) + problem_instance.get_cost(node2)
+                                         - problem_instance.get_distance(before, removed) - problem_instance.get_distance(removed, after) - problem_instance.get_cost(removed);
 
                             if (delta < best_delta) {
                                 best_delta = delta;
@@ -199,10 +292,84 @@ std::vector<int> local_search(
                                 if (T == SearchType::GREEDY && delta < -epsilon) goto apply_move;
                             }
                         }
+
+                        // Move 3: Remove n1, insert n2 on an edge next to one of its own candidates.
+                        // Edges touching n1 are skipped: inserting there is the plain exchange.
+                        if constexpr (UseReinsertion) {
+                            if (solution_size >= 5) {
+                                const double insertion_base = node1_removal_delta + problem_instance.get_cost(node2);
+                                const int* node2_candidates = candidate_neighbors->of(node2);
+                                for (int c2 = 0; c2 < candidate_neighbors->k; ++c2) {
+                                    const int pos_w = node_to_sol_pos[node2_candidates[c2]];
+                                    if (pos_w == -1) continue;
+                                    for (int side = 0; side < 2; ++side) {
+                                        const int pos_a = side ? (pos_w - 1 + solution_size) % solution_size : pos_w;
+                                        const int pos_b = (pos_a + 1) % solution_size;
+                                        if (pos_a == pos1 || pos_b == pos1) continue;
+                                        const int a = solution[pos_a];
+                                        const int b = solution[pos_b];
+
+                                        double delta = insertion_base + problem_instance.get_distance(a, node2) + problem_instance.get_distance(node2, b)
+                                                     - problem_instance.get_distance(a, b);
+                                        if (delta < best_delta) {
+                                            best_delta = delta;
+                                            best_pos1 = pos1;
+                                            best_pos2_or_id = node2;
+                                            best_pos_in_not_used = pos_in_not_in_sol;
+                                            best_target_pos = pos_a;
+                                            best_intra_or_inter = NeighbourhoodType::REINSERTION;
+                                            if (T == SearchType::GREEDY && delta < -epsilon) goto apply_move;
+                                        }
+                                    }
+                                }
+                            }
+                        }
                     }
-                    // CHECK 2: Node2 IS in solution -> Try INTRA exchange
+                    // CHECK 2: Node2 IS in solution -> Try OR-OPT and INTRA exchange
                     else {
                         int pos2 = node_to_sol_pos[node2];
+
+                        // Or-opt: relocate a segment of 1..3 nodes that starts or ends at node1 so that
+                        // node1 lands next to node2, i.e. between (pred2, node2) or (node2, succ2).
+                        // The segment is reversed when needed to put node1 on the node2 side.
+                        if constexpr (UseOrOpt)
+                        for (int len = 1; len <= OR_OPT_MAX_SEGMENT_LENGTH && len + 3 <= solution_size; ++len) {
+                            for (int ends_at_node1 = 0; ends_at_node1 < 2; ++ends_at_node1) {
+                                if (len == 1 && ends_at_node1) break; // Same single-node segment
+                                int seg_start = ends_at_node1 ? (pos1 - len + 1 + solution_size) % solution_size : pos1;
+                                if ((pos2 - seg_start + solution_size) % solution_size < len) continue;
+
+                                int target_before = (pos2 - 1 + solution_size) % solution_size;
+                                if ((target_before - seg_start + solution_size) % solution_size >= len) {
+                                    bool reversed = !ends_at_node1 && len > 1;
+                                    double delta = or_opt_delta(problem_instance, solution, seg_start, len, target_before, reversed);
+                                    if (delta < best_delta) {
+                                        best_delta = delta;
+                                        best_pos1 = seg_start;
+                                        best_pos2_or_id = target_before;
+                                        best_segment_length = len;
+                                        best_segment_reversed = reversed;
+                                        best_intra_or_inter = NeighbourhoodType::OR_OPT;
+                                        if (T == SearchType::GREEDY && delta < -epsilon) goto apply_move;
+                                    }
+                                }
+
+                                int target_after = (pos2 + 1) % solution_size;
+                                if ((target_after - seg_start + solution_size) % solution_size >= len) {
+                                    bool reversed = ends_at_node1 && len > 1;
+                                    double delta = or_opt_delta(problem_instance, solution, seg_start, len, pos2, reversed);
+                                    if (delta < best_delta) {
+                                        best_delta = delta;
+                                        best_pos1 = seg_start;
+                                        best_pos2_or_id = pos2;
+                                        best_segment_length = len;
+                                        best_segment_reversed = reversed;
+                                        best_intra_or_inter = NeighbourhoodType::OR_OPT;
+                                        if (T == SearchType::GREEDY && delta < -epsilon) goto apply_move;
+                                    }
+                                }
+                            }
+                        }
                         
                         // Skip if adjacent (standard 2-opt restriction)
                         if (pos2 == pos1_next || pos2 == pos1_prev) continue;
@@ -266,25 +433,111 @@ std::vector<int> local_search(
                         }
                     }
                 }
+
+                // Pair exchange: replace the pair (x1, x2) at (pair_start, pair_start + 1), between
+                // tour nodes p and q, with unused nodes (y1, y2). Built from either end: y1 from the
+                // candidates of p and y2 from those of y1, or y2 from q and y1 from y2. Candidate
+                // lists are sorted by d + cost, so both loops stop once the partial cost plus the
+                // smallest possible rest can no longer beat the best move.
+                if constexpr (UsePairExchange) {
+                    if (solution_size >= 5 && not_in_solution_size >= 2) {
+                        for (int pair_start : {pos1_prev, pos1}) {
+                            const int pos_x2 = (pair_start + 1) % solution_size;
+                            const int p = solution[(pair_start - 1 + solution_size) % solution_size];
+                            const int x1 = solution[pair_start];
+                            const int x2 = solution[pos_x2];
+                            const int q = solution[(pos_x2 + 1) % solution_size];
+                            const int removed = problem_instance.get_distance(p, x1) + problem_instance.get_distance(x1, x2) + problem_instance.get_distance(x2, q)
+                                              + problem_instance.get_cost(x1) + problem_instance.get_cost(x2);
+
+                            for (int from_q = 0; from_q < 2; ++from_q) {
+                                const int end_1 = from_q ? q : p; // Tour node next to the first chosen node
+                                const int end_2 = from_q ? p : q;
+                                const int* first_candidates = candidate_neighbors->of(end_1);
+                                const int* first_distances = candidate_neighbors->distances_of(end_1);
+                                for (int c1 = 0; c1 < candidate_neighbors->k; ++c1) {
+                                    const double threshold = std::min(best_delta, -epsilon) + removed;
+                                    const int z1 = first_candidates[c1];
+                                    const int key_1 = first_distances[c1] + problem_instance.get_cost(z1);
+                                    if (key_1 + min_nearest_key >= threshold) break;
+                                    if (node_to_sol_pos[z1] != -1 || key_1 + nearest_key(z1) >= threshold) continue;
+
+                                    const int* second_candidates = candidate_neighbors->of(z1);
+                                    const int* second_distances = candidate_neighbors->distances_of(z1);
+                                    for (int c2 = 0; c2 < candidate_neighbors->k; ++c2) {
+                                        const int z2 = second_candidates[c2];
+                                        const int key_2 = key_1 + second_distances[c2] + problem_instance.get_cost(z2);
+                                        if (key_2 >= threshold) break;
+                                        if (node_to_sol_pos[z2] != -1) continue;
+
+                                        double delta = key_2 + problem_instance.get_distance(z2, end_2) - removed;
+                                        if (delta < best_delta) {
+                                            best_delta = delta;
+                                            best_pos1 = pair_start;
+                                            best_pos2_or_id = from_q ? z2 : z1;
+                                            best_second_node = from_q ? z1 : z2;
+                                            best_intra_or_inter = NeighbourhoodType::PAIR_EXCHANGE;
+                                            if (T == SearchType::GREEDY && delta < -epsilon) goto apply_move;
+                                        }
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+
+                // Steepest: the best move around this node; otherwise its bit stays set
+                if (best_delta < -epsilon) break;
             }
         }
         // ============================================================
         // BRANCH: EFFICIENT ITERATOR (FULL NEIGHBORHOOD)
         // ============================================================
         else {
-            // Shuffle arrays for random sampling order
-            std::shuffle(solution_pos, solution_pos + solution_size, rng);
-            std::shuffle(not_in_solution, not_in_solution + not_in_solution_size, rng);
-            
-            // Note: When not using candidates, we don't need to update `node_to_not_in_pos`
-            // because we iterate `not_in_solution` directly.
+            // Moves are visited in a random order of their flat indices instead of shuffling
+            // positions and nodes, so `not_in_solution` and its lookup stay valid across passes
+            long long scanned_inter_limit = inter_limit;
+            if (scan_inter_rows) {
+                for (int pos1 = 0; pos1 < solution_size; ++pos1) {
+                    const int before_node_1 = solution[(pos1 - 1 + solution_size) % solution_size];
+                    const int after_node_1 = solution[(pos1 + 1) % solution_size];
+                    const int node_1 = solution[pos1];
+
+                    if (inter_best_node[node_1] == INTER_CACHE_STALE) {
+                        const int* row_before = problem_instance.get_distance_row(before_node_1);
+                        const int* row_after = problem_instance.get_distance_row(after_node_1);
+                        if (!sorted_rows || !best_inter_exchange_sorted(*sorted_rows, node_costs, before_node_1, after_node_1,
+                                                                        row_before, row_after, masked_costs, data_size,
+                                                                        inter_best_node[node_1], inter_best_value[node_1])) {
+                            inter_best_value[node_1] = best_inter_exchange(row_before, row_after, masked_costs,
+                                                                           data_size, inter_best_node[node_1]);
+                        }
+                    }
+                    const int best_node = inter_best_node[node_1];
+                    const int best_value = inter_best_value[node_1];
+                    if (best_node == -1) break; // Every node is in the solution
+
+                    const double delta = best_value
+                                       - problem_instance.get_distance(before_node_1, node_1) - problem_instance.get_distance(node_1, after_node_1) - problem_instance.get_cost(node_1);
+                    if (delta < best_delta) {
+                        best_delta = delta;
+                        best_pos1 = pos1;
+                        best_pos2_or_id = best_node;
+                        best_pos_in_not_used = node_to_not_in_pos[best_node];
+                        best_intra_or_inter = NeighbourhoodType::INTER;
+                    }
+                }
+                scanned_inter_limit = 0;
+            }
+            inter_order.reset(scanned_inter_limit, rng);
+            intra_order.reset(intra_limit, rng);
             
-            int inter_iterator = 0;
-            int intra_iterator = 0;
+            long long inter_iterator = 0;
+            long long intra_iterator = 0;
 
-            while (inter_iterator < inter_limit || intra_iterator < intra_limit){
+            while (inter_iterator < scanned_inter_limit || intra_iterator < intra_limit){
                 const bool can_do_intra = intra_iterator < intra_limit;
-                const bool can_do_inter = inter_iterator < inter_limit;
+                const bool can_do_inter = inter_iterator < scanned_inter_limit;
                 
                 if (!can_do_intra && !can_do_inter) break;
                 
@@ -300,16 +553,8 @@ std::vector<int> local_search(
                 }
 
                 if (intra_or_inter == NeighbourhoodType::INTRA){
-                    // Decode intra_iterator to (row, col)
-                    int i = intra_iterator;
-                    int row = 0;
-                    while (i >= (solution_size - 1 - row)) {
-                        i -= (solution_size - 1 - row);
-                        row++;
-                    }
-                    int col = row + 1 + i;
-                    pos1 = solution_pos[row];
-                    pos2_or_id = solution_pos[col];
+                    // Decode the next intra index to a pair of positions
+                    decode_pair_index(intra_order.next(), solution_size, pos1, pos2_or_id);
                     
                     const int pos1_plus_1 = (pos1 + 1) % solution_size;
                     const int pos2_plus_1 = (pos2_or_id + 1) % solution_size;
@@ -327,17 +572,18 @@ std::vector<int> local_search(
                     }
                     intra_iterator++;
                 } else {
-                    // Decode inter_iterator
-                    pos1 = solution_pos[inter_iterator / not_in_solution_size];
-                    pos_in_not_used = inter_iterator % not_in_solution_size;
+                    // Decode the next inter index to (position, index in not_in_solution)
+                    const long long inter_index = inter_order.next();
+                    pos1 = static_cast<int>(inter_index / not_in_solution_size);
+                    pos_in_not_used = static_cast<int>(inter_index % not_in_solution_size);
                     pos2_or_id = not_in_solution[pos_in_not_used];
                     
                     const int before_node_1 = solution[(pos1 - 1 + solution_size) % solution_size];
                     const int after_node_1 = solution[(pos1 + 1) % solution_size];
                     const int node_1 = solution[pos1];
                     
-                    delta = problem_instance.get_distance(before_node_1, pos2_or_id) + problem_instance.get_distance(pos2_or_id, after_node_1) + problem_instance.get_point(pos2_or_id).cost
-                          - problem_instance.get_distance(before_node_1, node_1) - problem_instance.get_distance(node_1, after_node_1) - problem_instance.get_point(node_1).cost;
+                    delta = problem_instance.get_distance(before_node_1, pos2_or_id) + problem_instance.get_distance(pos2_or_id, after_node_1) + problem_instance.get_cost(pos2_or_id)
+                          - problem_instance.get_distance(before_node_1, node_1) - problem_instance.get_distance(node_1, after_node_1) - problem_instance.get_cost(node_1);
                     
                     inter_iterator++;
                 }
@@ -362,9 +608,71 @@ std::vector<int> local_search(
             break;
         } 
 
+        // Nodes whose tour neighbours change; read before the move shifts positions
+        if (best_intra_or_inter == NeighbourhoodType::OR_OPT) {
+            num_changed_nodes = 0;
+            changed_nodes[num_changed_nodes++] = solution[(best_pos1 - 1 + solution_size) % solution_size];
+            for (int i = 0; i < best_segment_length; ++i) {
+                changed_nodes[num_changed_nodes++] = solution[(best_pos1 + i) % solution_size];
+            }
+            changed_nodes[num_changed_nodes++] = solution[(best_pos1 + best_segment_length) % solution_size];
+            changed_nodes[num_changed_nodes++] = solution[best_pos2_or_id];
+            changed_nodes[num_changed_nodes++] = solution[(best_pos2_or_id + 1) % solution_size];
+        } else if (best_intra_or_inter == NeighbourhoodType::REINSERTION) {
+            num_changed_nodes = 0;
+            changed_nodes[num_changed_nodes++] = solution[(best_pos1 - 1 + solution_size) % solution_size];
+            changed_nodes[num_changed_nodes++] = solution[best_pos1];
+            changed_nodes[num_changed_nodes++] = solution[(best_pos1 + 1) % solution_size];
+            changed_nodes[num_changed_nodes++] = solution[best_target_pos];
+            changed_nodes[num_changed_nodes++] = solution[(best_target_pos + 1) % solution_size];
+            changed_nodes[num_changed_nodes++] = best_pos2_or_id;
+        } else if (best_intra_or_inter == NeighbourhoodType::PAIR_EXCHANGE) {
+            num_changed_nodes = 0;
+            for (int offset = -1; offset <= 2; ++offset) {
+                changed_nodes[num_changed_nodes++] = solution[(best_pos1 + offset + solution_size) % solution_size];
+            }
+            changed_nodes[num_changed_nodes++] = best_pos2_or_id;
+            changed_nodes[num_changed_nodes++] = best_second_node;
+        }
+
         // Apply best move
-        apply_change(best_intra_or_inter, solution, best_pos1, best_pos2_or_id, 
-                    best_pos_in_not_used, not_in_solution);
+        if (best_intra_or_inter == NeighbourhoodType::OR_OPT) {
+            int first_changed, num_changed;
+            apply_or_opt(solution, best_pos1, best_segment_length, best_pos2_or_id, best_segment_reversed,
+                         first_changed, num_changed);
+            for (int i = 0; i < num_changed; ++i) {
+                int pos = (first_changed + i) % solution_size;
+                node_to_sol_pos[solution[pos]] = pos;
+            }
+        } else if (best_intra_or_inter == NeighbourhoodType::REINSERTION) {
+            // Exchange in place, then move the new node to its edge as a one-node Or-opt move
+            apply_change(NeighbourhoodType::INTER, solution, best_pos1, best_pos2_or_id,
+                         best_pos_in_not_used, not_in_solution);
+            int first_changed, num_changed;
+            apply_or_opt(solution, best_pos1, 1, best_target_pos, false, first_changed, num_changed);
+            for (int i = 0; i < num_changed; ++i) {
+                int pos = (first_changed + i) % solution_size;
+                node_to_sol_pos[solution[pos]] = pos;
+            }
+        } else if (best_intra_or_inter == NeighbourhoodType::PAIR_EXCHANGE) {
+            // Two in-place exchanges; their lookups are updated here as well
+            const int pos_2 = (best_pos1 + 1) % solution_size;
+            const int entering[2] = {best_pos2_or_id, best_second_node};
+            const int positions[2] = {best_pos1, pos_2};
+            for (int i = 0; i < 2; ++i) {
+                const int slot = node_to_not_in_pos[entering[i]];
+                const int leaving = solution[positions[i]];
+                apply_change(NeighbourhoodType::INTER, solution, positions[i], entering[i], slot, not_in_solution);
+                node_to_sol_pos[entering[i]] = positions[i];
+                node_to_sol_pos[leaving] = -1;
+                node_to_not_in_pos[leaving] = slot;
+                node_to_not_in_pos[entering[i]] = -1;
+            }
+        } else {
+            apply_change(best_intra_or_inter, solution, best_pos1, best_pos2_or_id, 
+                        best_pos_in_not_used, not_in_solution);
+        }
+        current_objective += best_delta;
         
         // --- UPDATE LOOKUP ARRAYS ---
         // Crucial for Candidate Moves efficiency to maintain O(1) lookups
@@ -380,7 +688,42 @@ std::vector<int> local_search(
             
             node_to_not_in_pos[removed_node] = best_pos_in_not_used;
             node_to_not_in_pos[added_node] = -1;
-        } else {
+
+            if (scan_inter_rows) {
+                masked_costs[added_node] = INTER_EXCLUDED_COST;
+                masked_costs[removed_node] = problem_instance.get_cost(removed_node);
+
+                // Entries that chose the added node go stale; the others compare the removed node
+                // with their cached best in O(1), keeping the lowest-id tie break of the row scan
+                for (int pos = 0; pos < solution_size; ++pos) {
+                    const int node = solution[pos];
+                    const int cached = inter_best_node[node];
+                    if (cached == INTER_CACHE_STALE) continue;
+                    if (cached == added_node) {
+                        inter_best_node[node] = INTER_CACHE_STALE;
+                        continue;
+                    }
+                    const int before = solution[(pos - 1 + solution_size) % solution_size];
+                    const int after = solution[(pos + 1) % solution_size];
+                    const int value = problem_instance.get_distance(before, removed_node) + problem_instance.get_distance(removed_node, after)
+                                    + problem_instance.get_cost(removed_node);
+                    if (cached == -1 || value < inter_best_value[node] || (value == inter_best_value[node] && removed_node < cached)) {
+                        inter_best_node[node] = removed_node;
+                        inter_best_value[node] = value;
+                    }
+                }
+                inter_best_node[added_node] = INTER_CACHE_STALE;
+                inter_best_node[solution[(best_pos1 - 1 + solution_size) % solution_size]] = INTER_CACHE_STALE;
+                inter_best_node[solution[(best_pos1 + 1) % solution_size]] = INTER_CACHE_STALE;
+            }
+        } else if (best_intra_or_inter == NeighbourhoodType::REINSERTION) {
+            // The Or-opt step already placed the added node
+            int added_node = best_pos2_or_id;
+            int removed_node = not_in_solution[best_pos_in_not_used];
+            node_to_sol_pos[removed_node] = -1;
+            node_to_not_in_pos[removed_node] = best_pos_in_not_used;
+            node_to_not_in_pos[added_node] = -1;
+        } else if (best_intra_or_inter == NeighbourhoodType::INTRA) {
             // Intra moves (2-opt) reverse a segment.
             // We must update positions for all nodes in the reversed segment.
             // Segment is roughly between pos1 and pos2 (inclusive of elements between)
@@ -397,8 +740,55 @@ std::vector<int> local_search(
             int curr = start;
             while (curr != (end + 1) % solution_size) {
                 node_to_sol_pos[solution[curr]] = curr;
+                // Reversed nodes swap predecessor and successor, which changes their
+                // orientation-dependent 2-opt moves; waking them here costs nothing extra
+                if (use_candidate_moves) activate(solution[curr]);
                 curr = (curr + 1) % solution_size;
             }
+
+            // Only the four ends of the broken edges got new neighbours; reversed nodes keep theirs
+            if (scan_inter_rows) {
+                inter_best_node[solution[best_pos1]] = INTER_CACHE_STALE;
+                inter_best_node[solution[start]] = INTER_CACHE_STALE;
+                inter_best_node[solution[end]] = INTER_CACHE_STALE;
+                inter_best_node[solution[(end + 1) % solution_size]] = INTER_CACHE_STALE;
+            }
+        }
+        
+        // Re-activate the examined node and every node whose moves may have changed: the moves of
+        // a node read its tour neighbours up to two positions away and, for each candidate, the
+        // candidate's membership and tour neighbours. So around every node whose neighbours or
+        // membership changed, the nearby tour nodes and the tour nodes listing it are woken.
+        if (use_candidate_moves) {
+            activate(active_node);
+            if (best_intra_or_inter == NeighbourhoodType::INTER) {
+                num_changed_nodes = 4;
+                changed_nodes[0] = solution[(best_pos1 - 1 + solution_size) % solution_size];
+                changed_nodes[1] = solution[best_pos1];
+                changed_nodes[2] = solution[(best_pos1 + 1) % solution_size];
+                changed_nodes[3] = not_in_solution[best_pos_in_not_used];
+            } else if (best_intra_or_inter == NeighbourhoodType::INTRA) {
+                num_changed_nodes = 4;
+                changed_nodes[0] = solution[best_pos1];
+                changed_nodes[1] = solution[(best_pos1 + 1) % solution_size];
+                changed_nodes[2] = solution[best_pos2_or_id];
+                changed_nodes[3] = solution[(best_pos2_or_id + 1) % solution_size];
+            }
+            for (int i = 0; i < num_changed_nodes; ++i) {
+                const int changed = changed_nodes[i];
+                const int changed_pos = node_to_sol_pos[changed];
+                if (changed_pos != -1) {
+                    for (int offset = -2; offset <= 2; ++offset) {
+                        activate(solution[(changed_pos + offset + solution_size) % solution_size]);
+                    }
+                }
+                const int* listing = candidate_neighbors->listed_by_of(changed);
+                for (int c = 0; c < candidate_neighbors->listed_by_count(changed); ++c) {
+                    if (node_to_sol_pos[listing[c]] != -1) {
+                        activate(listing[c]);
+                    }
+                }
+            }
         }
         
         if (T == SearchType::GREEDY) {
@@ -408,11 +798,80 @@ std::vector<int> local_search(
     
     timer.end_stage();
 
-    // Cleanup
-    delete[] not_in_solution;
-    delete[] solution_pos;
-    delete[] node_to_sol_pos;
-    delete[] node_to_not_in_pos;
+    if (objective) {
+        check_objective(solution, problem_instance, current_objective, "local_search");
+        *objective = current_objective;
+    }
+}
+
+// Runs the candidate-move specialisation with the given Or-opt and reinsertion switches
+template <SearchType T, bool UseOrOpt, bool UseReinsertion>
+void run_candidate_kernel(
+    TSPProblem& problem_instance,
+    std::vector<int>& solution,
+    StageTimer& timer,
+    LocalSearchWorkspace& workspace,
+    int k_candidates,
+    double* objective,
+    bool use_pair_exchange
+) {
+    if (use_pair_exchange) local_search_kernel<T, true, UseOrOpt, UseReinsertion, true>(problem_instance, solution, timer, workspace, k_candidates, objective);
+    else                   local_search_kernel<T, true, UseOrOpt, UseReinsertion, false>(problem_instance, solution, timer, workspace, k_candidates, objective);
+}
+
+// Picks the candidate-move specialisation for the enabled neighbourhoods
+template <SearchType T>
+void dispatch_candidate_kernel(
+    TSPProblem& problem_instance,
+    std::vector<int>& solution,
+    StageTimer& timer,
+    LocalSearchWorkspace& workspace,
+    int k_candidates,
+    double* objective,
+    bool use_or_opt,
+    bool use_reinsertion,
+    bool use_pair_exchange
+) {
+    if (use_or_opt && use_reinsertion) run_candidate_kernel<T, true, true>(problem_instance, solution, timer, workspace, k_candidates, objective, use_pair_exchange);
+    else if (use_or_opt)               run_candidate_kernel<T, true, false>(problem_instance, solution, timer, workspace, k_candidates, objective, use_pair_exchange);
+    else if (use_reinsertion)          run_candidate_kernel<T, false, true>(problem_instance, solution, timer, workspace, k_candidates, objective, use_pair_exchange);
+    else                               run_candidate_kernel<T, false, false>(problem_instance, solution, timer, workspace, k_candidates, objective, use_pair_exchange);
+}
+
+}
 
-    return solution;
+std::vector<int> local_search(
+    TSPProblem& problem_instance,
+    std::vector<int> starting_solution,
+    SearchType T,
+    StageTimer& timer,
+    int k_candidates,
+    double* objective
+) {
+    LocalSearchWorkspace workspace(problem_instance.get_num_points());
+    local_search_in_place(problem_instance, starting_solution, T, timer, workspace, k_candidates, objective);
+    return starting_solution;
+}
+
+void local_search_in_place(
+    TSPProblem& problem_instance,
+    std::vector<int>& solution,
+    SearchType T,
+    StageTimer& timer,
+    LocalSearchWorkspace& workspace,
+    int k_candidates,
+    double* objective,
+    bool use_or_opt,
+    bool use_reinsertion,
+    bool use_pair_exchange
+) {
+    // Runtime dispatch to the explicit specialisations
+    if (k_candidates <= 0) {
+        if (T == SearchType::STEEPEST) local_search_kernel<SearchType::STEEPEST, false, false, false, false>(problem_instance, solution, timer, workspace, k_candidates, objective);
+        else                           local_search_kernel<SearchType::GREEDY, false, false, false, false>(problem_instance, solution, timer, workspace, k_candidates, objective);
+    } else if (T == SearchType::STEEPEST) {
+        dispatch_candidate_kernel<SearchType::STEEPEST>(problem_instance, solution, timer, workspace, k_candidates, objective, use_or_opt, use_reinsertion, use_pair_exchange);
+    } else {
+        dispatch_candidate_kernel<SearchType::GREEDY>(problem_instance, solution, timer, workspace, k_candidates, objective, use_or_opt, use_reinsertion, use_pair_exchange);
+    }
 }
@@ -4,6 +4,7 @@
 #include "../core/TSPProblem.h"
 #include "../core/point_data.h"
 #include "../core/stagetimer.h"
+#include "local_search_workspace.h"
 #include <algorithm>
 #include <vector>
 
@@ -20,12 +21,65 @@ enum class SearchType {
  */
 enum class NeighbourhoodType {
     INTER, ///< Moves involving a node in the solution and a node outside of it.
-    INTRA  ///< Moves involving only nodes already in the solution.
+    INTRA, ///< Moves involving only nodes already in the solution.
+    OR_OPT,     ///< Relocation of a short segment next to a candidate neighbour (candidate moves only).
+    REINSERTION,  ///< Exchange that inserts the new node at an edge next to its candidates (candidate moves only).
+    PAIR_EXCHANGE ///< Replacement of two consecutive nodes by two unused nodes (candidate moves only).
 };
 
+/**
+ * @brief Improves a solution with 2-opt (intra) and node exchange (inter) moves until no improving move is left.
+ * The extra candidate neighbourhoods (Or-opt, reinsertion and pair exchanges) are only available
+ * through local_search_in_place.
+ *
+ * @param problem_instance The TSPProblem instance.
+ * @param starting_solution The solution to improve.
+ * @param T Steepest (best move per pass) or greedy (first improving move).
+ * @param timer StageTimer recording the "local search" stage.
+ * @param k_candidates Number of candidate neighbours per node (-1 = full neighbourhood).
+ * @param objective Optional in/out objective. If it holds the objective of `starting_solution`
+ * that value is used, if it holds UNKNOWN_OBJECTIVE the starting solution is evaluated once.
+ * On return it holds the exact objective of the result, tracked from the applied deltas.
+ * @return The locally optimal solution.
+ */
 std::vector<int> local_search(TSPProblem &problem_instance,
                                      std::vector<int> starting_solution,
                                      SearchType T, StageTimer &timer,
-                                     int k_candidates = -1);
+                                     int k_candidates = -1,
+                                     double* objective = nullptr);
+
+/**
+ * @brief local_search that improves `solution` in place using the buffers and generator of `workspace`.
+ *
+ * Same search as local_search, which is this function on a copy with a fresh workspace.
+ * Repeated callers (the HEA, LNS) keep one workspace per thread so a call allocates nothing.
+ *
+ * @param problem_instance The TSPProblem instance.
+ * @param solution The solution to improve; holds the locally optimal solution on return.
+ * @param T Steepest (best move per pass) or greedy (first improving move).
+ * @param timer StageTimer recording the "local search" stage.
+ * @param workspace Scratch buffers and random number generator of the calling thread.
+ * @param k_candidates Number of candidate neighbours per node (-1 = full neighbourhood).
+ * @param objective Optional in/out objective, as in local_search.
+ * @param use_or_opt Whether candidate moves include Or-opt relocations of segments of up to
+ * OR_OPT_MAX_SEGMENT_LENGTH nodes next to a candidate neighbour. The search is compiled
+ * separately for every combination of T, candidate/full neighbourhood and this flag, so a
+ * disabled neighbourhood costs nothing in the inner loops.
+ * @param use_reinsertion Whether candidate moves include reinsertion exchanges (NeighbourhoodType::REINSERTION):
+ * remove a node and insert an unused candidate of it at the cheapest edge next to one of the
+ * unused node's own candidates.
+ * @param use_pair_exchange Whether candidate moves include pair exchanges (NeighbourhoodType::PAIR_EXCHANGE):
+ * replace two consecutive tour nodes with two unused nodes chained through the candidate lists.
+ * Helps on small instances, but from random starts on large ones it leads to worse optima.
+ */
+void local_search_in_place(TSPProblem& problem_instance,
+                           std::vector<int>& solution,
+                           SearchType T, StageTimer& timer,
+                           LocalSearchWorkspace& workspace,
+                           int k_candidates = -1,
+                           double* objective = nullptr,
+                           bool use_or_opt = false,
+                           bool use_reinsertion = false,
+                           bool use_pair_exchange = false);
 
 #endif // LOCAL_SEARCH_H
@@ -0,0 +1,20 @@
+#include "local_search_workspace.h"
+
+LocalSearchWorkspace::LocalSearchWorkspace(int data_size, unsigned int seed) : rng(seed) {
+    reserve(data_size);
+}
+
+void LocalSearchWorkspace::reserve(int data_size) {
+    if (static_cast<int>(node_to_sol_pos.size()) >= data_size) return;
+    not_in_solution.resize(data_size);
+    node_to_sol_pos.resize(data_size);
+    node_to_not_in_pos.resize(data_size);
+    active_queue.resize(data_size);
+    in_queue.resize(data_size);
+    masked_costs.resize(data_size);
+    inter_best_node.resize(data_size);
+    inter_best_value.resize(data_size);
+    edge_broken.resize(data_size);
+    node_inserted.resize(data_size);
+    in_solution.resize(data_size);
+}
@@ -0,0 +1,45 @@
+#ifndef LOCAL_SEARCH_WORKSPACE_H
+#define LOCAL_SEARCH_WORKSPACE_H
+
+#include <random>
+#include <vector>
+
+/**
+ * @brief Scratch buffers and random number generator shared by the searches of one thread.
+ *
+ * local_search needs a few node-indexed arrays per call. A workspace sized once for a problem
+ * lets repeated calls (the HEA improves every offspring) reuse them instead of allocating and
+ * freeing them, and seeds its generator from std::random_device only once. A workspace is not
+ * thread-safe: every thread needs its own.
+ */
+class LocalSearchWorkspace {
+public:
+    /**
+     * @brief Creates a workspace for problems with `data_size` nodes.
+     * @param data_size Number of nodes of the problem (the buffers grow later if needed).
+     * @param seed Seed of the random number generator.
+     */
+    explicit LocalSearchWorkspace(int data_size = 0, unsigned int seed = std::random_device{}());
+
+    /**
+     * @brief Makes every buffer hold at least `data_size` entries. Allocates only when it grows.
+     */
+    void reserve(int data_size);
+
+    std::mt19937 rng; ///< Random number generator for search order, mutation and destroy operators.
+
+    // Node-indexed buffers (contents are undefined between calls)
+    std::vector<int> not_in_solution;    ///< Nodes outside the solution.
+    std::vector<int> node_to_sol_pos;    ///< Position of a node in the solution, or -1.
+    std::vector<int> node_to_not_in_pos; ///< Index of a node in not_in_solution, or -1.
+    std::vector<int> active_queue;       ///< Don't-look-bit queue of nodes.
+    std::vector<char> in_queue;          ///< Whether a node is in active_queue.
+    std::vector<int> masked_costs;       ///< Node costs with the solution masked out (best_inter_exchange).
+    std::vector<int> inter_best_node;    ///< Best replacement cache: best outside node per tour node.
+    std::vector<int> inter_best_value;   ///< Best replacement cache: insertion value of that node.
+    std::vector<char> edge_broken;       ///< Multi-move search: whether a batch breaks the edge after a position.
+    std::vector<char> node_inserted;     ///< Multi-move search: whether a batch inserts a node.
+    std::vector<char> in_solution;       ///< Mutation operator: whether a node is in the mutated solution.
+};
+
+#endif // LOCAL_SEARCH_WORKSPACE_H
@@ -0,0 +1,202 @@
+#include "multi_move_local_search.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "../core/evaluation.h"
+#include "inter_node_exchange.h"
+#include "intra_edge_exchange.h"
+
+// Start of anonymous namespace
+// Functions inside here are local to this file only and are not exported.
+namespace {
+
+// An improving move found in a pass, stored by node ids so it can be located again after
+// earlier moves of the batch have shifted positions
+struct BatchMove {
+    double delta;
+    long long index; ///< Position of the move in the scan order, breaks ties between equal deltas
+    NeighbourhoodType type;
+    int edge_1;      ///< Position whose edge (pos, pos + 1) the move breaks
+    int edge_2;      ///< Second broken edge, by position
+    int node_a;      ///< Inter: node leaving the tour. Intra: first node of the first broken edge
+    int node_b;      ///< Inter: node entering the tour. Intra: second node of the first broken edge
+    int node_c;      ///< Intra: first node of the second broken edge
+    int node_d;      ///< Intra: second node of the second broken edge
+};
+
+}
+
+std::vector<int> multi_move_local_search(TSPProblem& problem_instance,
+                                         std::vector<int> starting_solution,
+                                         StageTimer& timer,
+                                         LocalSearchWorkspace& workspace,
+                                         double* objective) {
+    const int solution_size = starting_solution.size();
+    if (solution_size < 4) {
+        local_search_in_place(problem_instance, starting_solution, SearchType::STEEPEST, timer, workspace, -1, objective);
+        return starting_solution;
+    }
+
+    std::vector<int> solution = std::move(starting_solution);
+    double current_objective = 0.0;
+    if (objective) {
+        current_objective = is_objective_known(*objective) ? *objective : evaluate_solution(solution, problem_instance);
+    }
+
+    timer.start_stage("local search");
+
+    const int data_size = problem_instance.get_num_points();
+    const bool scan_inter_rows = problem_instance.has_distance_matrix();
+    workspace.reserve(data_size);
+
+    // Node costs with the nodes in the solution masked out (see best_inter_exchange)
+    int* masked_costs = workspace.masked_costs.data();
+    for (int i = 0; i < data_size; ++i) {
+        masked_costs[i] = problem_instance.get_cost(i);
+    }
+    // node_to_sol_pos[node] = position in the solution, or -1 if the node is not in it
+    int* node_to_sol_pos = workspace.node_to_sol_pos.data();
+    std::fill(node_to_sol_pos, node_to_sol_pos + data_size, -1);
+    for (int i = 0; i < solution_size; ++i) {
+        masked_costs[solution[i]] = INTER_EXCLUDED_COST;
+        node_to_sol_pos[solution[i]] = i;
+    }
+
+    const long long num_inter_indices = static_cast<long long>(solution_size) * data_size;
+    const double epsilon = 1e-9;
+
+    std::vector<BatchMove> moves;
+    moves.reserve(2 * solution_size);
+    // edge_broken is indexed by position, node_inserted by node id
+    char* edge_broken = workspace.edge_broken.data();
+    char* node_inserted = workspace.node_inserted.data();
+    std::fill(node_inserted, node_inserted + data_size, 0);
+
+    auto succ = [&](int node) { return solution[(node_to_sol_pos[node] + 1) % solution_size]; };
+
+    while (true) {
+        // --- SCAN: best exchange and best 2-opt move of every position ---
+        moves.clear();
+        for (int pos1 = 0; pos1 < solution_size; ++pos1) {
+            const int before_node_1 = solution[(pos1 - 1 + solution_size) % solution_size];
+            const int after_node_1 = solution[(pos1 + 1) % solution_size];
+            const int node_1 = solution[pos1];
+            const int removed = problem_instance.get_distance(before_node_1, node_1) + problem_instance.get_distance(node_1, after_node_1) + problem_instance.get_cost(node_1);
+
+            int best_node = -1;
+            int best_value = std::numeric_limits<int>::max();
+            if (scan_inter_rows) {
+                best_value = best_inter_exchange(problem_instance.get_distance_row(before_node_1),
+                                                 problem_instance.get_distance_row(after_node_1),
+                                                 masked_costs, data_size, best_node);
+            } else {
+                for (int x = 0; x < data_size; ++x) {
+                    if (masked_costs[x] == INTER_EXCLUDED_COST) continue;
+                    const int value = problem_instance.get_distance(before_node_1, x) + problem_instance.get_distance(x, after_node_1) + masked_costs[x];
+                    if (value < best_value) {
+                        best_value = value;
+                        best_node = x;
+                    }
+                }
+            }
+            if (best_node != -1 && best_value - removed < -epsilon) {
+                moves.push_back({static_cast<double>(best_value - removed),
+                                 static_cast<long long>(pos1) * data_size + best_node,
+                                 NeighbourhoodType::INTER,
+                                 (pos1 - 1 + solution_size) % solution_size, pos1,
+                                 node_1, best_node, -1, -1});
+            }
+
+            // 2-opt with every later edge that shares no node with (pos1, pos1 + 1)
+            double best_delta = -epsilon;
+            int best_pos2 = -1;
+            const int last = (pos1 == 0) ? solution_size - 1 : solution_size;
+            for (int pos2 = pos1 + 2; pos2 < last; ++pos2) {
+                const int node_j = solution[pos2];
+                const int node_j_plus_1 = solution[(pos2 + 1) % solution_size];
+                const double delta = problem_instance.get_distance(node_1, node_j) + problem_instance.get_distance(after_node_1, node_j_plus_1)
+                                   - problem_instance.get_distance(node_1, after_node_1) - problem_instance.get_distance(node_j, node_j_plus_1);
+                if (delta < best_delta) {
+                    best_delta = delta;
+                    best_pos2 = pos2;
+                }
+            }
+            if (best_pos2 != -1) {
+                moves.push_back({best_delta,
+                                 num_inter_indices + static_cast<long long>(pos1) * solution_size + best_pos2,
+                                 NeighbourhoodType::INTRA,
+                                 pos1, best_pos2,
+                                 node_1, after_node_1, solution[best_pos2], solution[(best_pos2 + 1) % solution_size]});
+            }
+        }
+        if (moves.empty()) break;
+
+        // --- SELECT: improving moves in (delta, index) order that break disjoint edges ---
+        std::sort(moves.begin(), moves.end(), [](const BatchMove& a, const BatchMove& b) {
+            return a.delta < b.delta || (a.delta == b.delta && a.index < b.index);
+        });
+        std::fill(edge_broken, edge_broken + solution_size, 0);
+        size_t num_selected = 0;
+        for (const BatchMove& move : moves) {
+            if (edge_broken[move.edge_1] || edge_broken[move.edge_2]) continue;
+            if (move.type == NeighbourhoodType::INTER && node_inserted[move.node_b]) continue;
+            edge_broken[move.edge_1] = 1;
+            edge_broken[move.edge_2] = 1;
+            if (move.type == NeighbourhoodType::INTER) node_inserted[move.node_b] = 1;
+            moves[num_selected++] = move;
+        }
+        moves.resize(num_selected);
+
+        // --- APPLY: check every selected move again on the current tour ---
+        for (const BatchMove& move : moves) {
+            if (move.type == NeighbourhoodType::INTER) {
+                node_inserted[move.node_b] = 0;
+                const int pos1 = node_to_sol_pos[move.node_a];
+                if (pos1 == -1 || node_to_sol_pos[move.node_b] != -1) continue;
+                const double delta = inter_node_exchange(problem_instance, solution, pos1, move.node_b);
+                if (delta >= -epsilon) continue;
+
+                masked_costs[move.node_a] = problem_instance.get_cost(move.node_a);
+                masked_costs[move.node_b] = INTER_EXCLUDED_COST;
+                node_to_sol_pos[move.node_a] = -1;
+                node_to_sol_pos[move.node_b] = pos1;
+                solution[pos1] = move.node_b;
+                current_objective += delta;
+            } else {
+                // Both broken edges must still run a -> b and c -> d, or both b -> a and d -> c;
+                // with only one of them reversed the exchange would split the tour in two
+                int from_1, from_2;
+                if (succ(move.node_a) == move.node_b && succ(move.node_c) == move.node_d) {
+                    from_1 = move.node_a;
+                    from_2 = move.node_c;
+                } else if (succ(move.node_b) == move.node_a && succ(move.node_d) == move.node_c) {
+                    from_1 = move.node_b;
+                    from_2 = move.node_d;
+                } else {
+                    continue;
+                }
+                const int pos1 = node_to_sol_pos[from_1];
+                const int pos2 = node_to_sol_pos[from_2];
+                const double delta = intra_edge_exchange(problem_instance, solution, pos1, pos2);
+                if (delta >= -epsilon) continue;
+
+                apply_intra_edge_exchange(solution, pos1, pos2);
+                for (int pos = (pos1 + 1) % solution_size; ; pos = (pos + 1) % solution_size) {
+                    node_to_sol_pos[solution[pos]] = pos;
+                    if (pos == pos2) break;
+                }
+                current_objective += delta;
+            }
+        }
+    }
+
+    timer.end_stage();
+
+    if (objective) {
+        check_objective(solution, problem_instance, current_objective, "multi_move_local_search");
+        *objective = current_objective;
+    }
+    return solution;
+}
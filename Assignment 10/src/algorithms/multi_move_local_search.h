@@ -0,0 +1,38 @@
+#ifndef MULTI_MOVE_LOCAL_SEARCH_H
+#define MULTI_MOVE_LOCAL_SEARCH_H
+
+#include <vector>
+#include "local_search.h"
+#include "../core/TSPProblem.h"
+#include "../core/stagetimer.h"
+
+/**
+ * @brief Steepest full-neighbourhood local search that applies many independent moves per pass.
+ *
+ * Each pass scans the same moves as the steepest full-neighbourhood local_search and keeps, for
+ * every solution position, its best inter exchange and its best 2-opt move (with the position as
+ * the first broken edge). The improving ones are sorted by (delta, scan index) and accepted
+ * greedily as long as they break no tour edge already broken by an accepted move and insert no
+ * node already inserted by one. The accepted moves are then applied in that order, each checked
+ * again on the current tour: an exchange still needs its node in the tour, a 2-opt move still
+ * needs both of its edges with the same orientation (a reversal caused by an earlier move of the
+ * batch can flip one of them), and the recomputed delta must still improve.
+ *
+ * The first move of every batch is the move steepest local_search would apply, so a pass never
+ * does less than one steepest step, and the search stops at a local optimum of the same
+ * neighbourhood.
+ *
+ * @param problem_instance The TSPProblem instance.
+ * @param starting_solution The solution to improve.
+ * @param timer StageTimer recording the "local search" stage.
+ * @param workspace Scratch buffers of the calling thread (see LocalSearchWorkspace).
+ * @param objective Optional in/out objective, as in local_search.
+ * @return The locally optimal solution.
+ */
+std::vector<int> multi_move_local_search(TSPProblem& problem_instance,
+                                         std::vector<int> starting_solution,
+                                         StageTimer& timer,
+                                         LocalSearchWorkspace& workspace,
+                                         double* objective = nullptr);
+
+#endif // MULTI_MOVE_LOCAL_SEARCH_H
@@ -4,6 +4,7 @@
 #include "local_search.h" // For NeighbourhoodType enum
 #include <stdexcept>
 #include <algorithm>
+#include <cmath>
 
 /**
  * @brief Generates parameters for an inter-route node exchange move.
@@ -51,18 +52,27 @@ std::vector<int> get_intra_edge_exchange(int i, int solution_size) {
     if (i < 0 || i >= totalPairs)
         throw std::out_of_range("Index i is out of range for edge exchange");
 
-    // This algorithm decodes a flat index 'i' into a pair of indices (row, col)
+    // This decodes a flat index 'i' into a pair of indices (row, col)
     // representing the strict upper triangle of a symmetric matrix (where row < col).
-    int row = 0;
-    while (i >= (solution_size - 1 - row)) {
-        i -= (solution_size - 1 - row);
-        row++;
-    }
-    int col = row + 1 + i;
+    int row, col;
+    decode_pair_index(i, solution_size, row, col);
 
     return {row, col}; // Return the *indices*
 }
 
+void decode_pair_index(long long index, int n, int& row, int& col) {
+    // Row r starts at index r * (2n - r - 1) / 2; invert that quadratic for the row of `index`
+    auto row_start = [n](long long r) { return r * (2LL * n - r - 1) / 2; };
+    const double b = 2.0 * n - 1.0;
+    long long r = static_cast<long long>((b - std::sqrt(b * b - 8.0 * static_cast<double>(index))) / 2.0);
+    if (r < 0) r = 0;
+    if (r > n - 2) r = n - 2;
+    while (r > 0 && row_start(r) > index) --r;
+    while (r < n - 2 && row_start(r + 1) <= index) ++r;
+    row = static_cast<int>(r);
+    col = static_cast<int>(r + 1 + (index - row_start(r)));
+}
+
 /**
  * @brief Applies a given move to the solution.
  *
@@ -1,6 +1,8 @@
 #ifndef NEIGHBORHOOD_UTILS_H
 #define NEIGHBORHOOD_UTILS_H
 
+#include <numeric>
+#include <random>
 #include <vector>
 #include "../core/TSPProblem.h"
 
@@ -15,6 +17,58 @@ std::vector<int> get_inter_node_exchange(
 
 std::vector<int> get_intra_edge_exchange(int i, int solution_size);
 
+/**
+ * @brief Decodes a flat index of the strict upper triangle of an n x n matrix in O(1).
+ *
+ * Pairs are numbered row by row: (0, 1), (0, 2), ..., (0, n-1), (1, 2), ... The row comes from
+ * the closed-form root of the row-start quadratic, corrected by at most a step for rounding.
+ *
+ * @param index Flat index in [0, n(n-1)/2).
+ * @param n Matrix size.
+ * @param row Output: row of the pair.
+ * @param col Output: column of the pair (row < col).
+ */
+void decode_pair_index(long long index, int n, int& row, int& col);
+
+/**
+ * @brief Visits 0..size-1 exactly once each in a pseudo-random order.
+ *
+ * Yields start, start + stride, start + 2 * stride, ... (mod size). With gcd(stride, size) = 1
+ * this is a bijection, so a randomised pass over a neighbourhood needs two random numbers
+ * instead of a shuffle, and every step is O(1).
+ */
+class StridePermutation {
+public:
+    /**
+     * @brief Starts a new pass over 0..size-1 with a random start and stride.
+     */
+    template <class Rng>
+    void reset(long long new_size, Rng& rng) {
+        size = new_size;
+        current = 0;
+        stride = 1;
+        if (size < 2) return;
+        current = std::uniform_int_distribution<long long>(0, size - 1)(rng);
+        stride = std::uniform_int_distribution<long long>(1, size - 1)(rng);
+        while (std::gcd(stride, size) != 1) {
+            stride = (stride % (size - 1)) + 1;
+        }
+    }
+
+    /// The next index of the pass (the pass repeats after `size` calls).
+    long long next() {
+        const long long value = current;
+        current += stride;
+        if (current >= size) current -= size;
+        return value;
+    }
+
+private:
+    long long size = 0;
+    long long stride = 1;
+    long long current = 0;
+};
+
 void apply_change(
     NeighbourhoodType intra_or_inter,
     std::vector<int>& solution,
@@ -0,0 +1,56 @@
+#include "or_opt.h"
+
+#include <algorithm>
+#include <vector>
+
+// Start of anonymous namespace
+// Functions inside here are local to this file only and are not exported.
+namespace {
+
+// Reverses the `length` consecutive positions starting at `first`, wrapping around the end
+void reverse_cyclic(std::vector<int>& solution, int first, int length) {
+    const int solution_size = solution.size();
+    int i = first;
+    int j = (first + length - 1) % solution_size;
+    for (int k = 0; k < length / 2; ++k) {
+        std::swap(solution[i], solution[j]);
+        i = (i + 1 == solution_size) ? 0 : i + 1;
+        j = (j == 0) ? solution_size - 1 : j - 1;
+    }
+}
+
+}
+
+void apply_or_opt(
+    std::vector<int>& solution,
+    int segment_start,
+    int segment_length,
+    int target_pos,
+    bool reversed,
+    int& first_changed,
+    int& num_changed
+) {
+    const int solution_size = solution.size();
+    const int segment_end = (segment_start + segment_length - 1) % solution_size;
+
+    // Nodes strictly between the segment and the target edge, walking forward or backward
+    const int forward_gap = (target_pos - segment_end + solution_size) % solution_size;
+    const int backward_gap = (segment_start - target_pos - 1 + solution_size) % solution_size;
+
+    // Swap the segment with the gap in place: reversing both parts and then the whole block
+    // exchanges them, and skipping the segment's own reversal leaves it reversed
+    if (forward_gap <= backward_gap) {
+        // [segment][gap] -> [gap][segment]
+        first_changed = segment_start;
+        num_changed = segment_length + forward_gap;
+        if (!reversed) reverse_cyclic(solution, segment_start, segment_length);
+        reverse_cyclic(solution, (segment_end + 1) % solution_size, forward_gap);
+    } else {
+        // [gap][segment] -> [segment][gap]
+        first_changed = (target_pos + 1) % solution_size;
+        num_changed = backward_gap + segment_length;
+        reverse_cyclic(solution, first_changed, backward_gap);
+        if (!reversed) reverse_cyclic(solution, segment_start, segment_length);
+    }
+    reverse_cyclic(solution, first_changed, num_changed);
+}
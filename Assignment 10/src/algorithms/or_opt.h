@@ -0,0 +1,73 @@
+#ifndef OR_OPT_H
+#define OR_OPT_H
+
+#include <vector>
+#include "../core/TSPProblem.h"
+
+/// Longest segment an Or-opt move relocates.
+const int OR_OPT_MAX_SEGMENT_LENGTH = 3;
+
+/**
+ * @brief Calculates the change in total tour cost (delta) for an Or-opt move.
+ *
+ * The move cuts the segment of `segment_length` nodes starting at `segment_start` out of the
+ * tour and reinserts it between the nodes at `target_pos` and `target_pos + 1`, optionally
+ * reversed. With the segment a..b, its neighbours p and q and the target edge (u, v):
+ *   delta = d(p, q) - d(p, a) - d(b, q) + d(u, a) + d(b, v) - d(u, v)   (a and b swap if reversed)
+ * Node costs do not change. Positions wrap around the end of the solution.
+ *
+ * @param problem_instance The TSPProblem instance containing distance information.
+ * @param solution The current solution vector.
+ * @param segment_start Position of the first node of the segment.
+ * @param segment_length Number of nodes in the segment (the tour must have at least segment_length + 3 nodes).
+ * @param target_pos Position of the first node of the target edge; neither end of the edge may lie in the segment.
+ * @param reversed Whether the segment is inserted in reverse order.
+ * @return The delta (change in cost). A negative value indicates an improvement.
+ */
+inline double or_opt_delta(
+    const TSPProblem& problem_instance,
+    const std::vector<int>& solution,
+    int segment_start,
+    int segment_length,
+    int target_pos,
+    bool reversed
+) {
+    const int solution_size = solution.size();
+    const int p = solution[(segment_start - 1 + solution_size) % solution_size];
+    const int a = solution[segment_start];
+    const int b = solution[(segment_start + segment_length - 1) % solution_size];
+    const int q = solution[(segment_start + segment_length) % solution_size];
+    const int u = solution[target_pos];
+    const int v = solution[(target_pos + 1) % solution_size];
+
+    const int first = reversed ? b : a;
+    const int last = reversed ? a : b;
+    return problem_instance.get_distance(p, q) + problem_instance.get_distance(u, first) + problem_instance.get_distance(last, v)
+         - problem_instance.get_distance(p, a) - problem_instance.get_distance(b, q) - problem_instance.get_distance(u, v);
+}
+
+/**
+ * @brief Applies an Or-opt move to the solution vector.
+ *
+ * This move corresponds to the delta calculated in or_opt_delta. Only the nodes between the
+ * segment and the target edge on the shorter side are shifted.
+ *
+ * @param solution The solution vector (will be modified in-place).
+ * @param segment_start Position of the first node of the segment.
+ * @param segment_length Number of nodes in the segment.
+ * @param target_pos Position of the first node of the target edge.
+ * @param reversed Whether the segment is inserted in reverse order.
+ * @param first_changed Output: first position whose node changed.
+ * @param num_changed Output: number of consecutive (wrapping) positions whose node changed.
+ */
+void apply_or_opt(
+    std::vector<int>& solution,
+    int segment_start,
+    int segment_length,
+    int target_pos,
+    bool reversed,
+    int& first_changed,
+    int& num_changed
+);
+
+#endif // OR_OPT_H
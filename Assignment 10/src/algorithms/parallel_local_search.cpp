@@ -0,0 +1,251 @@
+#include "parallel_local_search.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../core/evaluation.h"
+#include "inter_node_exchange.h"
+#include "intra_edge_exchange.h"
+
+// Start of anonymous namespace
+// Functions inside here are local to this file only and are not exported.
+namespace {
+
+// Solution positions per worker at minimum. Every pass wakes the pool and waits for it (a lock
+// round trip and a condition-variable wake-up per worker, a few microseconds), while one position
+// costs an inter row scan plus its share of the 2-opt scan; with fewer positions the wake-up is no
+// longer small next to a worker's share. Unlike parallel_for_blocks (core/parallel_blocks.h), the
+// threads live across passes and blocks are balanced by work, not by position count.
+const int MIN_POSITIONS_PER_THREAD = 64;
+
+// Best move of one part of the neighbourhood
+struct MoveChoice {
+    double delta = std::numeric_limits<double>::max();
+    long long index = std::numeric_limits<long long>::max(); ///< Position of the move in the scan order
+    NeighbourhoodType type = NeighbourhoodType::INTRA;
+    int pos1 = -1;
+    int pos2_or_id = -1;
+
+    // Total order on moves: smaller delta first, ties go to the move that comes first in the scan order
+    bool better_than(const MoveChoice& other) const {
+        return delta < other.delta || (delta == other.delta && index < other.index);
+    }
+};
+
+/**
+ * @brief Threads that run the same task once per pass; the calling thread acts as worker 0.
+ */
+class PassWorkers {
+public:
+    PassWorkers(int num_threads, std::function<void(int)> task) : task(std::move(task)) {
+        for (int t = 1; t < num_threads; ++t) {
+            threads.emplace_back(&PassWorkers::work, this, t);
+        }
+    }
+
+    ~PassWorkers() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        start_signal.notify_all();
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
+
+    // Runs task(t) for every worker t and returns once all of them are done
+    void run_pass() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            generation++;
+            pending = threads.size();
+        }
+        start_signal.notify_all();
+        task(0);
+        std::unique_lock<std::mutex> lock(mutex);
+        done_signal.wait(lock, [this] { return pending == 0; });
+    }
+
+private:
+    void work(int thread_index) {
+        long long seen_generation = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                start_signal.wait(lock, [&] { return stopping || generation != seen_generation; });
+                if (stopping) return;
+                seen_generation = generation;
+            }
+            task(thread_index);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (--pending == 0) done_signal.notify_one();
+            }
+        }
+    }
+
+    std::function<void(int)> task;
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable start_signal;
+    std::condition_variable done_signal;
+    long long generation = 0;
+    size_t pending = 0;
+    bool stopping = false;
+};
+
+}
+
+std::vector<int> parallel_steepest_local_search(TSPProblem& problem_instance,
+                                                std::vector<int> starting_solution,
+                                                StageTimer& timer,
+                                                int num_threads,
+                                                double* objective) {
+    const int solution_size = starting_solution.size();
+    if (solution_size < 4) {
+        return local_search(problem_instance, starting_solution, SearchType::STEEPEST, timer, -1, objective);
+    }
+
+    std::vector<int> solution = starting_solution;
+    double current_objective = 0.0;
+    if (objective) {
+        current_objective = is_objective_known(*objective) ? *objective : evaluate_solution(solution, problem_instance);
+    }
+
+    timer.start_stage("local search");
+
+    const int data_size = problem_instance.get_num_points();
+    const bool scan_inter_rows = problem_instance.has_distance_matrix();
+
+    // Node costs with the nodes in the solution masked out (see best_inter_exchange)
+    std::vector<int> masked_costs(data_size);
+    for (int i = 0; i < data_size; ++i) {
+        masked_costs[i] = problem_instance.get_cost(i);
+    }
+    for (int node : solution) {
+        masked_costs[node] = INTER_EXCLUDED_COST;
+    }
+
+    if (num_threads <= 0) {
+        num_threads = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    num_threads = std::max(1, std::min(num_threads, solution_size / MIN_POSITIONS_PER_THREAD));
+
+    // Contiguous position blocks of equal work: a position scans its inter moves (a vectorized
+    // row pass, or one scalar delta per node) plus the 2-opt moves with the positions after it
+    const long long inter_work = scan_inter_rows ? data_size / 8 + 1 : data_size;
+    const long long total_work = inter_work * solution_size + static_cast<long long>(solution_size) * (solution_size - 1) / 2;
+    std::vector<int> block_start(num_threads + 1, solution_size);
+    block_start[0] = 0;
+    {
+        long long work = 0;
+        int block = 1;
+        for (int pos = 0; pos < solution_size && block < num_threads; ++pos) {
+            work += inter_work + (solution_size - 1 - pos);
+            if (work * num_threads >= total_work * block) {
+                block_start[block++] = pos + 1;
+            }
+        }
+    }
+
+    // Inter moves are numbered pos * data_size + node, 2-opt moves follow as pos1 * solution_size + pos2
+    const long long num_inter_indices = static_cast<long long>(solution_size) * data_size;
+    std::vector<MoveChoice> thread_best(num_threads);
+
+    auto scan_block = [&](int thread_index) {
+        MoveChoice best;
+        for (int pos1 = block_start[thread_index]; pos1 < block_start[thread_index + 1]; ++pos1) {
+            const int before_node_1 = solution[(pos1 - 1 + solution_size) % solution_size];
+            const int after_node_1 = solution[(pos1 + 1) % solution_size];
+            const int node_1 = solution[pos1];
+            const int removed = problem_instance.get_distance(before_node_1, node_1) + problem_instance.get_distance(node_1, after_node_1) + problem_instance.get_cost(node_1);
+
+            // Inter: the best outside node for this position (lowest id on ties)
+            int best_node = -1;
+            int best_value = 0;
+            if (scan_inter_rows) {
+                best_value = best_inter_exchange(problem_instance.get_distance_row(before_node_1),
+                                                 problem_instance.get_distance_row(after_node_1),
+                                                 masked_costs.data(), data_size, best_node);
+            } else {
+                best_value = std::numeric_limits<int>::max();
+                for (int x = 0; x < data_size; ++x) {
+                    if (masked_costs[x] == INTER_EXCLUDED_COST) continue;
+                    const int value = problem_instance.get_distance(before_node_1, x) + problem_instance.get_distance(x, after_node_1) + masked_costs[x];
+                    if (value < best_value) {
+                        best_value = value;
+                        best_node = x;
+                    }
+                }
+            }
+            if (best_node != -1) {
+                MoveChoice move;
+                move.delta = best_value - removed;
+                move.index = static_cast<long long>(pos1) * data_size + best_node;
+                move.type = NeighbourhoodType::INTER;
+                move.pos1 = pos1;
+                move.pos2_or_id = best_node;
+                if (move.better_than(best)) best = move;
+            }
+
+            // Intra: 2-opt with every later edge that shares no node with (pos1, pos1 + 1)
+            const int node_i = node_1;
+            const int node_i_plus_1 = after_node_1;
+            const int last = (pos1 == 0) ? solution_size - 1 : solution_size;
+            for (int pos2 = pos1 + 2; pos2 < last; ++pos2) {
+                const int node_j = solution[pos2];
+                const int node_j_plus_1 = solution[(pos2 + 1) % solution_size];
+                const double delta = problem_instance.get_distance(node_i, node_j) + problem_instance.get_distance(node_i_plus_1, node_j_plus_1)
+                                   - problem_instance.get_distance(node_i, node_i_plus_1) - problem_instance.get_distance(node_j, node_j_plus_1);
+                if (delta < best.delta) {
+                    // Within a position the 2-opt moves are scanned in index order, so only a
+                    // strictly smaller delta can win against a move found earlier at this position
+                    MoveChoice move;
+                    move.delta = delta;
+                    move.index = num_inter_indices + static_cast<long long>(pos1) * solution_size + pos2;
+                    move.type = NeighbourhoodType::INTRA;
+                    move.pos1 = pos1;
+                    move.pos2_or_id = pos2;
+                    best = move;
+                }
+            }
+        }
+        thread_best[thread_index] = best;
+    };
+
+    const double epsilon = 1e-9;
+    PassWorkers workers(num_threads, scan_block);
+
+    while (true) {
+        workers.run_pass();
+
+        // Reduce in thread order; the total order on moves makes the result independent of the split
+        MoveChoice best = thread_best[0];
+        for (int t = 1; t < num_threads; ++t) {
+            if (thread_best[t].better_than(best)) best = thread_best[t];
+        }
+        if (best.delta >= -epsilon) break;
+
+        if (best.type == NeighbourhoodType::INTER) {
+            masked_costs[solution[best.pos1]] = problem_instance.get_cost(solution[best.pos1]);
+            masked_costs[best.pos2_or_id] = INTER_EXCLUDED_COST;
+            solution[best.pos1] = best.pos2_or_id;
+        } else {
+            apply_intra_edge_exchange(solution, best.pos1, best.pos2_or_id);
+        }
+        current_objective += best.delta;
+    }
+
+    timer.end_stage();
+
+    if (objective) {
+        check_objective(solution, problem_instance, current_objective, "parallel_steepest_local_search");
+        *objective = current_objective;
+    }
+    return solution;
+}
@@ -0,0 +1,37 @@
+#ifndef PARALLEL_LOCAL_SEARCH_H
+#define PARALLEL_LOCAL_SEARCH_H
+
+#include <vector>
+#include "local_search.h"
+#include "../core/TSPProblem.h"
+#include "../core/stagetimer.h"
+
+/**
+ * @brief Steepest full-neighbourhood local search with the neighbourhood split over threads.
+ *
+ * Explores the same moves as the full-neighbourhood branch of local_search with
+ * SearchType::STEEPEST: every inter exchange (solution position x outside node) and every 2-opt
+ * move (pair of positions). Each pass splits the solution positions into contiguous blocks of
+ * equal work, one per thread; a thread evaluates the inter moves of its positions and the 2-opt
+ * moves whose first position is in its block. The threads live for the whole call and are
+ * woken once per pass.
+ *
+ * Moves are ordered by (delta, move index), where inter moves come first by position and node
+ * id and 2-opt moves follow by position pair. Every thread keeps the smallest move in that order
+ * and the partial results are reduced in thread order, so the applied move, and therefore the
+ * result, is the same for every thread count. The scan has no random order to break ties.
+ *
+ * @param problem_instance The TSPProblem instance.
+ * @param starting_solution The solution to improve.
+ * @param timer StageTimer recording the "local search" stage.
+ * @param num_threads Number of threads, 0 = one per hardware thread. Small solutions use fewer.
+ * @param objective Optional in/out objective, as in local_search.
+ * @return The locally optimal solution.
+ */
+std::vector<int> parallel_steepest_local_search(TSPProblem& problem_instance,
+                                                std::vector<int> starting_solution,
+                                                StageTimer& timer,
+                                                int num_threads = 0,
+                                                double* objective = nullptr);
+
+#endif // PARALLEL_LOCAL_SEARCH_H
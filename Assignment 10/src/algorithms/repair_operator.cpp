@@ -1,8 +1,9 @@
 #include "repair_operator.h"
+#include "../core/evaluation.h"
 #include <cmath>
 #include <limits>
 
-std::vector<int> repair_solution(const std::vector<int>& partial_solution, const TSPProblem& problem) {
+std::vector<int> repair_solution(const std::vector<int>& partial_solution, const TSPProblem& problem, double* objective) {
     int total_nodes = problem.get_num_points();
     int num_to_select = static_cast<int>(ceil(static_cast<double>(total_nodes) / 2.0));
 
@@ -24,10 +25,14 @@ std::vector<int> repair_solution(const std::vector<int>& partial_solution, const
         }
     }
 
+    // Each insertion changes the objective by exactly its cost_change
+    double current_objective = objective ? evaluate_solution(solution, problem) : 0.0;
+
     // Iteratively insert nodes based on the 2-regret heuristic weighted with equal weight with basic greedy
     while ((int)solution.size() < num_to_select) {
         int best_node_to_insert = -1;
         int best_insertion_idx = -1;
+        double best_insertion_cost = 0.0;
         double best_weighted_objective = -std::numeric_limits<double>::infinity();
 
         // Iterate through all unvisited nodes to find the one with the best objective function
@@ -46,7 +51,7 @@ std::vector<int> repair_solution(const std::vector<int>& partial_solution, const
                     double cost_change = problem.get_distance(current_node_id, k) + 
                                          problem.get_distance(k, next_node_id) - 
                                          problem.get_distance(current_node_id, next_node_id) + 
-                                         problem.get_point(k).cost;
+                                         problem.get_cost(k);
 
                     if (cost_change < best_cost) {
                         second_best_cost = best_cost;
@@ -64,6 +69,7 @@ std::vector<int> repair_solution(const std::vector<int>& partial_solution, const
                     best_weighted_objective = weighted_objective;
                     best_node_to_insert = k;
                     best_insertion_idx = current_best_insertion_idx;
+                    best_insertion_cost = best_cost;
                 }
             }
         }
@@ -71,11 +77,16 @@ std::vector<int> repair_solution(const std::vector<int>& partial_solution, const
         if (best_node_to_insert != -1) {
             solution.insert(solution.begin() + best_insertion_idx, best_node_to_insert);
             visited[best_node_to_insert] = true;
+            current_objective += best_insertion_cost;
         } else {
             // No more unvisited nodes to insert
             break;
         }
     }
 
+    if (objective) {
+        check_objective(solution, problem, current_objective, "repair_solution");
+        *objective = current_objective;
+    }
     return solution;
 }
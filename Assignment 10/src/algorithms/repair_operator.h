@@ -9,8 +9,10 @@
  * 
  * @param partial_solution The partial solution to be repaired.
  * @param problem The TSP problem instance.
+ * @param objective Optional output: the exact objective of the returned solution, accumulated
+ * from the insertion costs (only the partial solution is evaluated in full).
  * @return A complete solution with 50% of nodes.
  */
-std::vector<int> repair_solution(const std::vector<int>& partial_solution, const TSPProblem& problem);
+std::vector<int> repair_solution(const std::vector<int>& partial_solution, const TSPProblem& problem, double* objective = nullptr);
 
 #endif // REPAIR_OPERATOR_H
@@ -1,46 +1,124 @@
 #include "TSPProblem.h"
 
 #include <vector>
-#include <cmath>
+#include <map>
+#include <mutex>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
 #include "point_data.h"
+#include "aligned_buffer.h"
+#include "distance_matrix.h"
+#include "instance_bundle.h"
 
 // Start of anonymous namespace
 // Functions inside here are local to this file only and are not exported.
-namespace { 
+namespace {
 
-// Function to calculate the Euclidean distance between two points and round it to the nearest integer
-int calculate_distance(const PointData& p1, const PointData& p2) {
-    double dist = std::sqrt(std::pow(p1.x - p2.x, 2) + std::pow(p1.y - p2.y, 2));
-    return static_cast<int>(std::round(dist));
-}
+// Number of ints in one cache line; every matrix row is padded to a multiple of this
+const size_t INTS_PER_CACHE_LINE = CACHE_LINE_SIZE / sizeof(int);
 
-// Function to pre-calculate the distance matrix for all pairs of points
-std::vector<std::vector<int>> calculate_distance_matrix(const std::vector<PointData>& data) {
-    size_t n = data.size();
-    std::vector<std::vector<int>> matrix(n, std::vector<int>(n, 0));
-    for (size_t i = 0; i < n; ++i) {
-        for (size_t j = i + 1; j < n; ++j) {
-            int dist = calculate_distance(data[i], data[j]);
-            matrix[i][j] = dist;
-            matrix[j][i] = dist;
+/**
+ * @brief Debug check for the vectorized matrix build.
+ * When built with -DVERIFY_DISTANCE_MATRIX the matrix is rebuilt with the scalar reference kernel
+ * and std::logic_error is thrown at the first differing entry; otherwise this compiles to nothing.
+ */
+void check_distance_matrix(const int* xs, const int* ys, int n, const int* matrix, size_t row_stride) {
+#ifdef VERIFY_DISTANCE_MATRIX
+    std::vector<int> expected(static_cast<size_t>(n) * row_stride);
+    build_distance_matrix_scalar(xs, ys, n, expected.data(), row_stride);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            size_t index = static_cast<size_t>(i) * row_stride + j;
+            if (matrix[index] != expected[index]) {
+                throw std::logic_error("distance matrix entry (" + std::to_string(i) + ", " + std::to_string(j) + ") is " +
+                                       std::to_string(matrix[index]) + ", scalar kernel gives " + std::to_string(expected[index]));
+            }
         }
     }
-    return matrix;
+#else
+    (void)xs;
+    (void)ys;
+    (void)n;
+    (void)matrix;
+    (void)row_stride;
+#endif
+}
+
 }
 
+void TSPProblem::split_points() {
+    size_t n = points.size();
+    coord_x.resize(n);
+    coord_y.resize(n);
+    node_cost.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        coord_x[i] = points[i].x;
+        coord_y[i] = points[i].y;
+        node_cost[i] = points[i].cost;
+    }
 }
 
-TSPProblem::TSPProblem(const std::vector<PointData>& points) {
+struct TSPProblem::CandidateCache {
+    std::mutex mutex;
+    std::map<int, std::unique_ptr<CandidateLists>> lists_by_k;
+};
+
+TSPProblem::TSPProblem(const std::vector<PointData>& points, DistanceMode mode, bool use_huge_pages) {
     this->points = points;
-    this->distance_matrix = calculate_distance_matrix(points);
+    size_t n = points.size();
+    split_points();
+
+    if (mode == DistanceMode::MATRIX) {
+        this->row_stride = (n + INTS_PER_CACHE_LINE - 1) / INTS_PER_CACHE_LINE * INTS_PER_CACHE_LINE;
+        std::shared_ptr<int> storage = make_aligned_array<int>(n * row_stride, CACHE_LINE_SIZE, use_huge_pages);
+        build_distance_matrix(coord_x.data(), coord_y.data(), static_cast<int>(n), storage.get(), row_stride);
+        check_distance_matrix(coord_x.data(), coord_y.data(), static_cast<int>(n), storage.get(), row_stride);
+        this->distance_storage = storage;
+        this->distance_matrix = storage.get();
+    } else {
+        this->row_stride = 0;
+        this->distance_matrix = nullptr;
+    }
+    this->candidate_cache = std::make_shared<CandidateCache>();
+}
+
+TSPProblem::TSPProblem(const InstanceBundle& bundle) {
+    size_t n = bundle.num_points();
+    this->points.assign(bundle.points(), bundle.points() + n);
+    split_points();
+
+    // Share ownership of the mapping while pointing straight at the matrix inside it
+    this->distance_storage = std::shared_ptr<const void>(bundle.mapping(), bundle.distance_matrix());
+    this->distance_matrix = bundle.distance_matrix();
+    this->row_stride = bundle.row_stride();
+
+    this->candidate_cache = std::make_shared<CandidateCache>();
+    for (int s = 0; s < bundle.num_candidate_sets(); ++s) {
+        std::unique_ptr<CandidateLists> lists(new CandidateLists());
+        lists->k = bundle.candidate_k(s);
+        size_t count = n * lists->k;
+        lists->neighbors.assign(bundle.candidate_neighbors(s), bundle.candidate_neighbors(s) + count);
+        lists->distances.assign(bundle.candidate_distances(s), bundle.candidate_distances(s) + count);
+        build_reverse_candidate_lists(*lists, static_cast<int>(n));
+        candidate_cache->lists_by_k[lists->k] = std::move(lists);
+    }
 }
 
 PointData TSPProblem::get_point(int id) const {
     return points[id];
 }
 
-int TSPProblem::get_distance(int id1, int id2) const {
-    return distance_matrix[id1][id2];
+const CandidateLists& TSPProblem::get_candidates(int K) const {
+    // Requests for K >= n - 1 all describe the same full lists
+    int k = std::max(0, std::min(K, get_num_points() - 1));
+
+    std::lock_guard<std::mutex> lock(candidate_cache->mutex);
+    std::unique_ptr<CandidateLists>& entry = candidate_cache->lists_by_k[k];
+    if (!entry) {
+        entry.reset(new CandidateLists(build_candidate_lists(*this, k)));
+    }
+    return *entry;
 }
 
 int TSPProblem::get_num_points() const {
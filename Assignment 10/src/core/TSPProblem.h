@@ -1,24 +1,80 @@
 #ifndef TSPPROBLEM_H
 #define TSPPROBLEM_H
 
+#include <cstddef>
+#include <memory>
 #include <vector>
 #include "point_data.h"
+#include "candidate_lists.h"
+#include "geometry.h"
+#include "array_view.h"
+
+class InstanceBundle;
+
+/**
+ * @brief Selects how a TSPProblem answers distance queries.
+ */
+enum class DistanceMode {
+    MATRIX,   ///< Full pre-calculated n x n matrix: O(n^2) memory, one load per query.
+    ON_DEMAND ///< Rounded distances computed from the coordinates per query: O(n) memory.
+};
 
 /**
  * @brief Represents the Traveling Salesperson Problem (TSP) data structure.
  * Stores the list of points and the pre-calculated distance matrix.
+ *
+ * Coordinates and node costs are additionally kept as separate contiguous arrays
+ * (structure of arrays). Hot loops should read them through the inlined get_cost / get_x /
+ * get_y accessors or the get_costs / get_xs / get_ys views instead of copying whole
+ * PointData records with get_point.
+ *
+ * The distance matrix is kept in a single contiguous, cache-line-aligned row-major buffer.
+ * Every row is padded to a multiple of 16 ints (64 bytes) so that each row starts on its own
+ * cache line. The buffer is immutable after construction and shared between copies.
+ * Candidate neighbour lists are built lazily, once per K, and cached alongside the matrix.
+ *
+ * In DistanceMode::ON_DEMAND no matrix is allocated at all; get_distance computes the
+ * rounded Euclidean distance from structure-of-arrays coordinates instead, and only the
+ * O(nK) candidate lists (with their edge distances) are stored. This allows instances far
+ * too large for an n x n matrix to be solved through the same interface.
+ *
+ * A problem can also be opened from a precomputed InstanceBundle, in which case the matrix
+ * is used directly from the memory-mapped file and the stored candidate lists are preloaded.
  */
 class TSPProblem {
 private:
     std::vector<PointData> points;
-    std::vector<std::vector<int>> distance_matrix;
+    std::vector<int> coord_x;              ///< x coordinate of every point (structure of arrays).
+    std::vector<int> coord_y;              ///< y coordinate of every point (structure of arrays).
+    std::vector<int> node_cost;            ///< Cost of every point (structure of arrays).
+    std::shared_ptr<const void> distance_storage; ///< Owner of the matrix (aligned buffer or bundle mapping).
+    const int* distance_matrix;            ///< Row-major matrix, row i starts at i * row_stride (null in ON_DEMAND mode).
+    size_t row_stride;                     ///< Number of ints between the starts of consecutive rows.
+
+    struct CandidateCache;
+    std::shared_ptr<CandidateCache> candidate_cache; ///< Candidate lists built so far, keyed by K.
+
+    /// Fills the structure-of-arrays copies (coordinates, costs) from `points`.
+    void split_points();
 
 public:
     /**
      * @brief Constructor for the TSPProblem.
      * @param points A constant reference to the vector of points.
+     * @param mode Whether to pre-calculate the full distance matrix or compute distances on demand.
+     * @param use_huge_pages Whether to request transparent huge pages for a large matrix.
      */
-    TSPProblem(const std::vector<PointData>& points);
+    TSPProblem(const std::vector<PointData>& points,
+               DistanceMode mode = DistanceMode::MATRIX,
+               bool use_huge_pages = false);
+
+    /**
+     * @brief Constructs a problem from an opened instance bundle without any preprocessing.
+     * The distance matrix stays in the bundle's mapping (kept alive by the problem) and the
+     * bundle's candidate lists seed the candidate cache.
+     * @param bundle A successfully opened bundle.
+     */
+    explicit TSPProblem(const InstanceBundle& bundle);
 
     /**
      * @brief Retrieves a point by its ID (index).
@@ -28,13 +84,83 @@ public:
     PointData get_point(int id) const;
 
     /**
-     * @brief Retrieves the pre-calculated distance between two points.
+     * @brief Retrieves the cost of a point.
+     * @param id The index of the point.
+     * @return The cost of including the point in a solution.
+     */
+    int get_cost(int id) const;
+
+    /**
+     * @brief Retrieves the x coordinate of a point.
+     * @param id The index of the point.
+     * @return The x coordinate.
+     */
+    int get_x(int id) const;
+
+    /**
+     * @brief Retrieves the y coordinate of a point.
+     * @param id The index of the point.
+     * @return The y coordinate.
+     */
+    int get_y(int id) const;
+
+    /**
+     * @brief Retrieves the costs of all points as one contiguous array, indexed by point id.
+     * @return A view of get_num_points() costs.
+     */
+    ArrayView<int> get_costs() const;
+
+    /**
+     * @brief Retrieves the x coordinates of all points as one contiguous array, indexed by point id.
+     * @return A view of get_num_points() coordinates.
+     */
+    ArrayView<int> get_xs() const;
+
+    /**
+     * @brief Retrieves the y coordinates of all points as one contiguous array, indexed by point id.
+     * @return A view of get_num_points() coordinates.
+     */
+    ArrayView<int> get_ys() const;
+
+    /**
+     * @brief Retrieves the distance between two points.
+     * Reads the pre-calculated matrix, or computes the value when no matrix is stored.
      * @param id1 The index of the first point.
      * @param id2 The index of the second point.
      * @return The integer distance between the two points.
      */
     int get_distance(int id1, int id2) const;
 
+    /**
+     * @brief Retrieves a raw pointer to the row of the distance matrix for one point.
+     * Entry j of the row is the distance from `id` to point j. Entries past
+     * get_num_points() (row padding) are zero. Only valid if has_distance_matrix().
+     * @param id The index of the point.
+     * @return Pointer to the first element of the row (aligned to a cache line).
+     */
+    const int* get_distance_row(int id) const;
+
+    /**
+     * @brief Checks whether the full distance matrix is stored (DistanceMode::MATRIX).
+     * @return true if get_distance_row may be used.
+     */
+    bool has_distance_matrix() const;
+
+    /**
+     * @brief Retrieves the number of ints between the starts of consecutive matrix rows.
+     * @return The row stride (a multiple of 16, at least get_num_points()).
+     */
+    size_t get_row_stride() const;
+
+    /**
+     * @brief Retrieves the candidate neighbour lists for a given K.
+     * The lists are built on the first request for a K and reused by every later call
+     * (thread-safe). The returned reference stays valid for the lifetime of the problem.
+     * @param K Number of candidates per node.
+     * @return The shared candidate lists.
+     */
+    const CandidateLists& get_candidates(int K) const;
+
     /**
      * @brief Retrieves the number of points in the problem.
      * @return The number of points.
@@ -48,4 +174,52 @@ public:
     const std::vector<PointData>& get_points() const;
 };
 
+// Hot accessors are defined inline so the search loops avoid a call per lookup. Costs and
+// coordinates are plain array loads. get_distance is one load from the padded matrix row when the
+// matrix was built, and otherwise a rounded Euclidean distance from the coordinate arrays, behind a
+// branch on distance_matrix that stays predictable because it never changes for an instance.
+
+inline int TSPProblem::get_cost(int id) const {
+    return node_cost[id];
+}
+
+inline int TSPProblem::get_x(int id) const {
+    return coord_x[id];
+}
+
+inline int TSPProblem::get_y(int id) const {
+    return coord_y[id];
+}
+
+inline ArrayView<int> TSPProblem::get_costs() const {
+    return ArrayView<int>(node_cost.data(), node_cost.size());
+}
+
+inline ArrayView<int> TSPProblem::get_xs() const {
+    return ArrayView<int>(coord_x.data(), coord_x.size());
+}
+
+inline ArrayView<int> TSPProblem::get_ys() const {
+    return ArrayView<int>(coord_y.data(), coord_y.size());
+}
+
+inline int TSPProblem::get_distance(int id1, int id2) const {
+    if (distance_matrix) {
+        return distance_matrix[static_cast<size_t>(id1) * row_stride + id2];
+    }
+    return rounded_euclidean_distance(coord_x[id1] - coord_x[id2], coord_y[id1] - coord_y[id2]);
+}
+
+inline const int* TSPProblem::get_distance_row(int id) const {
+    return distance_matrix + static_cast<size_t>(id) * row_stride;
+}
+
+inline bool TSPProblem::has_distance_matrix() const {
+    return distance_matrix != nullptr;
+}
+
+inline size_t TSPProblem::get_row_stride() const {
+    return row_stride;
+}
+
 #endif // TSPPROBLEM_H
@@ -0,0 +1,52 @@
+#include "aligned_buffer.h"
+
+#include <cstdlib>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace {
+
+const size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+}
+
+void* aligned_allocate(size_t bytes, size_t alignment, bool use_huge_pages) {
+    const bool huge = use_huge_pages && bytes >= HUGE_PAGE_SIZE;
+    if (huge && alignment < HUGE_PAGE_SIZE) {
+        alignment = HUGE_PAGE_SIZE;
+    }
+    // Round the size up so that the whole block consists of full alignment units
+    bytes = (bytes + alignment - 1) / alignment * alignment;
+
+    void* ptr = nullptr;
+#if defined(_WIN32)
+    ptr = _aligned_malloc(bytes, alignment);
+#else
+    if (posix_memalign(&ptr, alignment, bytes) != 0) {
+        ptr = nullptr;
+    }
+#endif
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+
+#if defined(MADV_HUGEPAGE)
+    if (huge) {
+        // Best effort only: if transparent huge pages are disabled the block stays on 4 KB pages
+        madvise(ptr, bytes, MADV_HUGEPAGE);
+    }
+#endif
+    return ptr;
+}
+
+void aligned_free(void* ptr) {
+#if defined(_WIN32)
+    _aligned_free(ptr);
+#else
+    free(ptr);
+#endif
+}
@@ -0,0 +1,45 @@
+#ifndef ALIGNED_BUFFER_H
+#define ALIGNED_BUFFER_H
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+
+/// Alignment used for hot read-only tables (one x86 cache line).
+const size_t CACHE_LINE_SIZE = 64;
+
+/**
+ * @brief Allocates a block of raw memory with the requested alignment.
+ *
+ * When `use_huge_pages` is set and the block is at least one huge page (2 MB) large,
+ * the block is aligned to the huge page size and the kernel is advised to back it
+ * with transparent huge pages (Linux only, silently ignored elsewhere).
+ *
+ * @param bytes Size of the block in bytes.
+ * @param alignment Required alignment in bytes (power of two, multiple of sizeof(void*)).
+ * @param use_huge_pages Whether to request huge pages for large blocks.
+ * @return Pointer to the block. Throws std::bad_alloc on failure.
+ */
+void* aligned_allocate(size_t bytes, size_t alignment, bool use_huge_pages = false);
+
+/**
+ * @brief Releases a block obtained from aligned_allocate.
+ */
+void aligned_free(void* ptr);
+
+/**
+ * @brief Allocates a zero-initialised, aligned array of `count` elements of a trivial type.
+ * The returned shared pointer releases the memory with aligned_free, so copies of the owner
+ * can share one immutable table.
+ */
+template <typename T>
+std::shared_ptr<T> make_aligned_array(size_t count, size_t alignment = CACHE_LINE_SIZE, bool use_huge_pages = false) {
+    size_t bytes = count * sizeof(T);
+    if (bytes == 0) bytes = alignment;
+    T* data = static_cast<T*>(aligned_allocate(bytes, alignment, use_huge_pages));
+    std::memset(data, 0, bytes);
+    return std::shared_ptr<T>(data, [](T* p) { aligned_free(p); });
+}
+
+#endif // ALIGNED_BUFFER_H
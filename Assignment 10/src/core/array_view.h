@@ -0,0 +1,28 @@
+#ifndef ARRAY_VIEW_H
+#define ARRAY_VIEW_H
+
+#include <cstddef>
+
+/**
+ * @brief Non-owning, read-only view of a contiguous array (a minimal span).
+ * Used to hand structure-of-arrays data to kernels without copying it.
+ */
+template <typename T>
+class ArrayView {
+public:
+    ArrayView() : ptr(nullptr), count(0) {}
+    ArrayView(const T* data, size_t size) : ptr(data), count(size) {}
+
+    const T* data() const { return ptr; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const T& operator[](size_t i) const { return ptr[i]; }
+    const T* begin() const { return ptr; }
+    const T* end() const { return ptr + count; }
+
+private:
+    const T* ptr;
+    size_t count;
+};
+
+#endif // ARRAY_VIEW_H
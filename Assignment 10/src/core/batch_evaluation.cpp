@@ -0,0 +1,154 @@
+#include "batch_evaluation.h"
+
+#include <algorithm>
+#include <climits>
+#include "evaluation.h"
+#include "parallel_blocks.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BATCH_EVALUATION_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+// Start of anonymous namespace
+// Functions inside here are local to this file only and are not exported.
+namespace {
+
+// Tour edges worth a thread of their own (see parallel_for_blocks)
+const size_t MIN_EDGES_PER_THREAD = 1 << 15;
+
+// Objective of one tour, read straight from the flat matrix and the cost array
+typedef long long (*TourKernel)(const int* tour, size_t length, const int* matrix, int row_stride, const int* costs);
+
+long long evaluate_tour_scalar(const int* tour, size_t length, const int* matrix, int row_stride, const int* costs) {
+    long long total = 0;
+    for (size_t i = 0; i < length; ++i) {
+        const int from = tour[i];
+        const int to = tour[(i + 1 == length) ? 0 : i + 1];
+        total += costs[from] + matrix[static_cast<size_t>(from) * row_stride + to];
+    }
+    return total;
+}
+
+#ifdef BATCH_EVALUATION_X86_SIMD
+
+__attribute__((target("avx2")))
+long long evaluate_tour_avx2(const int* tour, size_t length, const int* matrix, int row_stride, const int* costs) {
+    const __m256i stride = _mm256_set1_epi32(row_stride);
+    __m256i sum = _mm256_setzero_si256();
+    size_t i = 0;
+    // Eight edges (tour[i+k], tour[i+k+1]) per step; the closing edge is left to the scalar tail
+    for (; i + 8 < length; i += 8) {
+        __m256i from = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tour + i));
+        __m256i to = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tour + i + 1));
+        __m256i index = _mm256_add_epi32(_mm256_mullo_epi32(from, stride), to);
+        __m256i distance = _mm256_i32gather_epi32(matrix, index, 4);
+        __m256i cost = _mm256_i32gather_epi32(costs, from, 4);
+        // Widen to 64-bit lanes so long tours cannot overflow the accumulator
+        sum = _mm256_add_epi64(sum, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(distance)));
+        sum = _mm256_add_epi64(sum, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(distance, 1)));
+        sum = _mm256_add_epi64(sum, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(cost)));
+        sum = _mm256_add_epi64(sum, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(cost, 1)));
+    }
+
+    alignas(32) long long lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), sum);
+    long long total = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    for (; i < length; ++i) {
+        const int from = tour[i];
+        const int to = tour[(i + 1 == length) ? 0 : i + 1];
+        total += costs[from] + matrix[static_cast<size_t>(from) * row_stride + to];
+    }
+    return total;
+}
+
+#endif // BATCH_EVALUATION_X86_SIMD
+
+// Picks the gather kernel when the CPU supports it and every matrix index fits the 32-bit gather offsets
+TourKernel select_tour_kernel(const TSPProblem& problem_instance) {
+#ifdef BATCH_EVALUATION_X86_SIMD
+    const size_t matrix_size = static_cast<size_t>(problem_instance.get_num_points()) * problem_instance.get_row_stride();
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && matrix_size <= static_cast<size_t>(INT_MAX)) {
+        return evaluate_tour_avx2;
+    }
+#else
+    (void)problem_instance;
+#endif
+    return evaluate_tour_scalar;
+}
+
+// Splits [0, num_tours) into per-thread blocks, sizing them by edge count rather than tour count
+template <typename RangeFunc>
+void parallel_over_tours(size_t num_tours, size_t tour_length, int num_threads, RangeFunc evaluate_range) {
+    const size_t min_tours_per_thread = std::max<size_t>(1, MIN_EDGES_PER_THREAD / std::max<size_t>(tour_length, 1));
+    parallel_for_blocks(num_tours, min_tours_per_thread, num_threads, evaluate_range);
+}
+
+}
+
+void evaluate_solutions_batch(const int* tours, size_t num_tours, size_t tour_length,
+                              const TSPProblem& problem_instance, double* objectives,
+                              int num_threads) {
+    if (num_tours == 0) {
+        return;
+    }
+
+    if (!problem_instance.has_distance_matrix()) {
+        // Distances are computed on demand; nothing to gather from
+        parallel_over_tours(num_tours, tour_length, num_threads, [&](size_t first, size_t last) {
+            for (size_t t = first; t < last; ++t) {
+                const int* tour = tours + t * tour_length;
+                objectives[t] = evaluate_solution(std::vector<int>(tour, tour + tour_length), problem_instance);
+            }
+        });
+        return;
+    }
+
+    const TourKernel kernel = select_tour_kernel(problem_instance);
+    const int* matrix = problem_instance.get_distance_row(0);
+    const int row_stride = static_cast<int>(problem_instance.get_row_stride());
+    const int* costs = problem_instance.get_costs().data();
+
+    parallel_over_tours(num_tours, tour_length, num_threads, [&](size_t first, size_t last) {
+        for (size_t t = first; t < last; ++t) {
+            const int* tour = tours + t * tour_length;
+            // A one-node tour has no edges (evaluate_solution skips the self-loop as well)
+            objectives[t] = (tour_length == 1)
+                ? costs[tour[0]]
+                : static_cast<double>(kernel(tour, tour_length, matrix, row_stride, costs));
+        }
+    });
+}
+
+std::vector<double> evaluate_solutions_batch(const std::vector<std::vector<int>>& solutions,
+                                             const TSPProblem& problem_instance,
+                                             int num_threads) {
+    std::vector<double> objectives(solutions.size());
+    if (solutions.empty()) {
+        return objectives;
+    }
+
+    const size_t tour_length = solutions.front().size();
+    bool equal_lengths = true;
+    for (const std::vector<int>& solution : solutions) {
+        equal_lengths = equal_lengths && solution.size() == tour_length;
+    }
+
+    if (!equal_lengths) {
+        parallel_over_tours(solutions.size(), tour_length, num_threads, [&](size_t first, size_t last) {
+            for (size_t t = first; t < last; ++t) {
+                objectives[t] = evaluate_solution(solutions[t], problem_instance);
+            }
+        });
+        return objectives;
+    }
+
+    std::vector<int> block;
+    block.reserve(solutions.size() * tour_length);
+    for (const std::vector<int>& solution : solutions) {
+        block.insert(block.end(), solution.begin(), solution.end());
+    }
+    evaluate_solutions_batch(block.data(), solutions.size(), tour_length, problem_instance, objectives.data(), num_threads);
+    return objectives;
+}
@@ -0,0 +1,50 @@
+#include "candidate_lists.h"
+
+#include <algorithm>
+#include "TSPProblem.h"
+#include "spatial_index.h"
+
+CandidateLists build_candidate_lists(const TSPProblem& problem, int K) {
+    int n = problem.get_num_points();
+    CandidateLists lists;
+    lists.k = std::max(0, std::min(K, n - 1));
+    lists.neighbors.resize(static_cast<size_t>(n) * lists.k);
+    lists.distances.resize(lists.neighbors.size());
+
+    // The k-d tree prunes whole regions that cannot enter a node's list,
+    // so the n x n score table is never materialised
+    SpatialIndex index(problem.get_points());
+    std::vector<int> neighbors;
+    neighbors.reserve(lists.k);
+
+    for (int i = 0; i < n; ++i) {
+        index.k_best_neighbors(i, lists.k, neighbors);
+        size_t offset = static_cast<size_t>(i) * lists.k;
+        for (int c = 0; c < lists.k; ++c) {
+            lists.neighbors[offset + c] = neighbors[c];
+            lists.distances[offset + c] = problem.get_distance(i, neighbors[c]);
+        }
+    }
+    build_reverse_candidate_lists(lists, n);
+    return lists;
+}
+
+void build_reverse_candidate_lists(CandidateLists& lists, int n) {
+    // Counting sort of the (node, candidate) pairs by candidate
+    lists.listed_by_offsets.assign(n + 1, 0);
+    for (int neighbor : lists.neighbors) {
+        lists.listed_by_offsets[neighbor + 1]++;
+    }
+    for (int i = 0; i < n; ++i) {
+        lists.listed_by_offsets[i + 1] += lists.listed_by_offsets[i];
+    }
+
+    lists.listed_by.resize(lists.neighbors.size());
+    std::vector<int> fill(lists.listed_by_offsets.begin(), lists.listed_by_offsets.end() - 1);
+    for (int i = 0; i < n; ++i) {
+        const int* candidates = lists.of(i);
+        for (int c = 0; c < lists.k; ++c) {
+            lists.listed_by[fill[candidates[c]]++] = i;
+        }
+    }
+}
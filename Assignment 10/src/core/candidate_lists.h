@@ -0,0 +1,70 @@
+#ifndef CANDIDATE_LISTS_H
+#define CANDIDATE_LISTS_H
+
+#include <cstddef>
+#include <vector>
+
+class TSPProblem;
+
+/**
+ * @brief Candidate neighbour lists for every node of a problem instance.
+ * Node i's candidates are the `k` nodes j != i with the smallest
+ * `distance(i, j) + cost(j)`, in ascending order (ties broken by node id).
+ * Lists are stored back to back in one flat array, `k` entries per node, together with
+ * the distance of every candidate edge so that callers without a distance matrix
+ * can read them without recomputing.
+ */
+struct CandidateLists {
+    int k = 0;                  ///< Number of candidates per node (min(K, n - 1)).
+    std::vector<int> neighbors; ///< Flattened lists, node i occupies [i * k, (i + 1) * k).
+    std::vector<int> distances; ///< distances[i * k + c] = distance(i, neighbors[i * k + c]).
+
+    /// Reverse lists: the nodes whose candidate list contains node i are
+    /// listed_by[listed_by_offsets[i] .. listed_by_offsets[i + 1]).
+    std::vector<int> listed_by_offsets;
+    std::vector<int> listed_by;
+
+    /**
+     * @brief Retrieves the candidate list of one node.
+     * @param node The node id.
+     * @return Pointer to the first of `k` candidate ids.
+     */
+    const int* of(int node) const { return neighbors.data() + static_cast<size_t>(node) * k; }
+
+    /**
+     * @brief Retrieves the cached candidate edge distances of one node.
+     * @param node The node id.
+     * @return Pointer to `k` distances, parallel to of(node).
+     */
+    const int* distances_of(int node) const { return distances.data() + static_cast<size_t>(node) * k; }
+
+    /**
+     * @brief Retrieves the nodes that have `node` among their candidates.
+     * @param node The node id.
+     * @return Pointer to the first of listed_by_count(node) node ids.
+     */
+    const int* listed_by_of(int node) const { return listed_by.data() + listed_by_offsets[node]; }
+
+    /**
+     * @brief Number of nodes that have `node` among their candidates.
+     */
+    int listed_by_count(int node) const { return listed_by_offsets[node + 1] - listed_by_offsets[node]; }
+};
+
+/**
+ * @brief Fills the reverse (listed_by) lists from the forward lists.
+ * @param lists Candidate lists whose `k` and `neighbors` are set.
+ * @param n Number of nodes.
+ */
+void build_reverse_candidate_lists(CandidateLists& lists, int n);
+
+/**
+ * @brief Builds the K-nearest candidate lists for a problem.
+ * Prefer TSPProblem::get_candidates, which builds each K only once and shares the result.
+ * @param problem The TSP problem instance.
+ * @param K Requested number of candidates per node.
+ * @return The candidate lists.
+ */
+CandidateLists build_candidate_lists(const TSPProblem& problem, int K);
+
+#endif // CANDIDATE_LISTS_H
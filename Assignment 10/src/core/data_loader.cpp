@@ -1,45 +1,95 @@
 #include "data_loader.h"
 #include <iostream>
-#include <fstream>
-#include <sstream>
 #include <vector>
 #include <string>
+#include <cstring>
+#include <algorithm>
+#include <charconv>
+#include "mapped_file.h"
+
+// Start of anonymous namespace
+// Functions inside here are local to this file only and are not exported.
+namespace {
+
+inline bool is_blank(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+// Parses one integer field starting at `p`, surrounded by optional blanks and terminated by
+// `separator` or the end of the line. On success `p` is left just past the separator.
+bool parse_field(const char*& p, const char* line_end, char separator, int& value) {
+    while (p < line_end && is_blank(*p)) ++p;
+    if (p < line_end && *p == '+') ++p;
+
+    std::from_chars_result result = std::from_chars(p, line_end, value);
+    if (result.ec != std::errc()) {
+        return false;
+    }
+    p = result.ptr;
+
+    while (p < line_end && is_blank(*p)) ++p;
+    if (separator == '\0') {
+        return p == line_end;
+    }
+    if (p == line_end || *p != separator) {
+        return false;
+    }
+    ++p;
+    return true;
+}
+
+}
 
 // Helper function to load data from a CSV file
+// The file is memory-mapped and the `x;y;cost` records are parsed in place, without
+// building any per-line strings or streams.
 bool load_data(const std::string& filename, std::vector<PointData>& data) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
+    MappedFile file;
+    if (!file.open(filename)) {
         std::cerr << "Error: could not open file " << filename << "\n";
         return false;
     }
 
+    const char* p = file.data();
+    const char* end = p + file.size();
+
     data.clear();
-    std::string line;
+    // One record per line, so the line count bounds the number of points
+    data.reserve(std::count(p, end, '\n') + 1);
+
     int current_id = 0;
+    int line_number = 0;
 
-    while (std::getline(file, line)) {
-        std::stringstream ss(line);
-        std::string value;
-        std::vector<int> values;
-        bool error = false;
-
-        while (std::getline(ss, value, ';')) {
-            try {
-                values.push_back(std::stoi(value));
-            } catch (...) {
-                error = true;
-                break;
-            }
+    while (p < end) {
+        ++line_number;
+        const char* line_end = static_cast<const char*>(std::memchr(p, '\n', end - p));
+        if (line_end == nullptr) {
+            line_end = end;
         }
+        const char* next_line = (line_end < end) ? line_end + 1 : end;
 
-        if (!error && values.size() == 3) {
-            data.push_back({current_id, values[0], values[1], values[2]});
+        // Blank lines (e.g. a trailing newline) are skipped silently
+        const char* q = p;
+        while (q < line_end && is_blank(*q)) ++q;
+        if (q == line_end) {
+            p = next_line;
+            continue;
+        }
+
+        int x, y, cost;
+        const char* field = p;
+        if (parse_field(field, line_end, ';', x) &&
+            parse_field(field, line_end, ';', y) &&
+            parse_field(field, line_end, '\0', cost)) {
+            data.push_back({current_id, x, y, cost});
             current_id++;
+        } else {
+            std::cerr << "Warning: skipping malformed line " << line_number << " in " << filename
+                      << " (expected x;y;cost)" << std::endl;
         }
+        p = next_line;
     }
 
-    file.close();
-
     if (data.empty()) {
         std::cerr << "Error: No data loaded from " << filename << std::endl;
         return false;
@@ -0,0 +1,98 @@
+#include "distance_matrix.h"
+
+#include "geometry.h"
+#include "parallel_blocks.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define DISTANCE_MATRIX_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+// Start of anonymous namespace
+// Functions inside here are local to this file only and are not exported.
+namespace {
+
+// Matrix rows worth a thread of their own (see parallel_for_blocks)
+const size_t MIN_ROWS_PER_THREAD = 512;
+
+// Computes row i of the matrix (columns 0..n-1)
+typedef void (*RowKernel)(const int* xs, const int* ys, int n, int i, int* row);
+
+void compute_row_scalar(const int* xs, const int* ys, int n, int i, int* row) {
+    const int qx = xs[i];
+    const int qy = ys[i];
+    for (int j = 0; j < n; ++j) {
+        row[j] = rounded_euclidean_distance(qx - xs[j], qy - ys[j]);
+    }
+}
+
+#ifdef DISTANCE_MATRIX_X86_SIMD
+
+__attribute__((target("avx2")))
+void compute_row_avx2(const int* xs, const int* ys, int n, int i, int* row) {
+    const __m256d qx = _mm256_set1_pd(xs[i]);
+    const __m256d qy = _mm256_set1_pd(ys[i]);
+    const __m256d half = _mm256_set1_pd(0.5);
+    int j = 0;
+    for (; j + 4 <= n; j += 4) {
+        __m256d dx = _mm256_sub_pd(qx, _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(xs + j))));
+        __m256d dy = _mm256_sub_pd(qy, _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ys + j))));
+        __m256d squared = _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+        __m256d rounded = _mm256_floor_pd(_mm256_add_pd(_mm256_sqrt_pd(squared), half));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(row + j), _mm256_cvttpd_epi32(rounded));
+    }
+    for (; j < n; ++j) {
+        row[j] = rounded_euclidean_distance(xs[i] - xs[j], ys[i] - ys[j]);
+    }
+}
+
+__attribute__((target("avx512f")))
+void compute_row_avx512(const int* xs, const int* ys, int n, int i, int* row) {
+    const __m512d qx = _mm512_set1_pd(xs[i]);
+    const __m512d qy = _mm512_set1_pd(ys[i]);
+    const __m512d half = _mm512_set1_pd(0.5);
+    int j = 0;
+    for (; j + 8 <= n; j += 8) {
+        __m512d dx = _mm512_sub_pd(qx, _mm512_cvtepi32_pd(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(xs + j))));
+        __m512d dy = _mm512_sub_pd(qy, _mm512_cvtepi32_pd(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(ys + j))));
+        __m512d squared = _mm512_add_pd(_mm512_mul_pd(dx, dx), _mm512_mul_pd(dy, dy));
+        __m512d rounded = _mm512_roundscale_pd(_mm512_add_pd(_mm512_sqrt_pd(squared), half),
+                                               _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(row + j), _mm512_cvttpd_epi32(rounded));
+    }
+    for (; j < n; ++j) {
+        row[j] = rounded_euclidean_distance(xs[i] - xs[j], ys[i] - ys[j]);
+    }
+}
+
+#endif // DISTANCE_MATRIX_X86_SIMD
+
+// Picks the widest kernel supported by the CPU we are running on
+RowKernel select_row_kernel() {
+#ifdef DISTANCE_MATRIX_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return compute_row_avx512;
+    if (__builtin_cpu_supports("avx2")) return compute_row_avx2;
+#endif
+    return compute_row_scalar;
+}
+
+}
+
+void build_distance_matrix(const int* xs, const int* ys, int n,
+                           int* matrix, size_t row_stride, int num_threads) {
+    const RowKernel kernel = select_row_kernel();
+
+    parallel_for_blocks(static_cast<size_t>(n), MIN_ROWS_PER_THREAD, num_threads, [=](size_t first_row, size_t last_row) {
+        for (size_t i = first_row; i < last_row; ++i) {
+            kernel(xs, ys, n, static_cast<int>(i), matrix + i * row_stride);
+        }
+    });
+}
+
+void build_distance_matrix_scalar(const int* xs, const int* ys, int n,
+                                  int* matrix, size_t row_stride) {
+    for (int i = 0; i < n; ++i) {
+        compute_row_scalar(xs, ys, n, i, matrix + static_cast<size_t>(i) * row_stride);
+    }
+}
@@ -0,0 +1,33 @@
+#ifndef DISTANCE_MATRIX_H
+#define DISTANCE_MATRIX_H
+
+#include <cstddef>
+
+/**
+ * @brief Fills a row-major distance matrix with rounded Euclidean distances.
+ *
+ * Every row is computed independently (both triangles), which lets whole row tiles be
+ * evaluated with SIMD and lets rows be split across threads without synchronisation.
+ * On x86 the widest available kernel (AVX-512F, AVX2 or scalar) is selected at runtime.
+ * The vector kernels round with floor(sqrt(d) + 0.5), which equals std::round for the
+ * square root of any non-negative integer below 2^52, so every kernel produces results
+ * bit-identical to rounded_euclidean_distance.
+ *
+ * @param xs x coordinates of the n points.
+ * @param ys y coordinates of the n points.
+ * @param n Number of points.
+ * @param matrix Output buffer of n * row_stride ints; entries past column n are left untouched.
+ * @param row_stride Number of ints between the starts of consecutive rows (>= n).
+ * @param num_threads Number of worker threads, 0 = one per hardware thread.
+ */
+void build_distance_matrix(const int* xs, const int* ys, int n,
+                           int* matrix, size_t row_stride, int num_threads = 0);
+
+/**
+ * @brief Scalar reference version of build_distance_matrix (single-threaded).
+ * Builds with -DVERIFY_DISTANCE_MATRIX compare every matrix TSPProblem builds against it.
+ */
+void build_distance_matrix_scalar(const int* xs, const int* ys, int n,
+                                  int* matrix, size_t row_stride);
+
+#endif // DISTANCE_MATRIX_H
@@ -2,10 +2,49 @@
 #define EVALUATION_H
 
 #include <vector>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
 #include "point_data.h"
 #include "TSPProblem.h"
 
-std::vector<std::vector<int>> calculate_distance_matrix(const std::vector<PointData>& data);
 double evaluate_solution(const std::vector<int>& solution, const TSPProblem& problem_instance);
 
+/// Marks an objective that has not been computed yet (functions taking an in/out objective
+/// evaluate the solution themselves when they receive this value).
+const double UNKNOWN_OBJECTIVE = std::numeric_limits<double>::quiet_NaN();
+
+/**
+ * @brief Checks whether an objective value is known (i.e. not UNKNOWN_OBJECTIVE).
+ */
+inline bool is_objective_known(double objective) {
+    return !std::isnan(objective);
+}
+
+/**
+ * @brief Debug check for incrementally tracked objectives.
+ * When built with -DVERIFY_INCREMENTAL_OBJECTIVE the solution is re-evaluated from scratch and
+ * std::logic_error is thrown if the tracked value differs; otherwise this compiles to nothing.
+ * @param solution The solution whose objective was tracked.
+ * @param problem_instance The TSP problem instance.
+ * @param objective The tracked objective.
+ * @param context Name of the caller, used in the error message.
+ */
+inline void check_objective(const std::vector<int>& solution, const TSPProblem& problem_instance,
+                            double objective, const char* context) {
+#ifdef VERIFY_INCREMENTAL_OBJECTIVE
+    double expected = evaluate_solution(solution, problem_instance);
+    if (std::abs(expected - objective) > 1e-6) {
+        throw std::logic_error(std::string(context) + ": tracked objective " + std::to_string(objective) +
+                               " differs from evaluated objective " + std::to_string(expected));
+    }
+#else
+    (void)solution;
+    (void)problem_instance;
+    (void)objective;
+    (void)context;
+#endif
+}
+
 #endif // EVALUATION_H
@@ -0,0 +1,18 @@
+#ifndef GEOMETRY_H
+#define GEOMETRY_H
+
+#include <cmath>
+
+/**
+ * @brief Euclidean length of a coordinate offset, rounded to the nearest integer.
+ * This is the distance definition used by every distance matrix and on-demand lookup,
+ * so all backends agree bit for bit.
+ * @param dx Offset along the x axis.
+ * @param dy Offset along the y axis.
+ * @return The rounded distance.
+ */
+inline int rounded_euclidean_distance(double dx, double dy) {
+    return static_cast<int>(std::round(std::sqrt(dx * dx + dy * dy)));
+}
+
+#endif // GEOMETRY_H
@@ -0,0 +1,271 @@
+#include "instance_bundle.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include "TSPProblem.h"
+#include "aligned_buffer.h"
+
+struct InstanceBundle::Header {
+    char magic[8];               ///< "TSPBNDL\0"
+    uint32_t version;            ///< FORMAT_VERSION
+    uint32_t byte_order;         ///< BYTE_ORDER_MARK as written by the producing machine
+    uint32_t num_points;
+    uint32_t row_stride;
+    uint32_t num_candidate_sets;
+    uint32_t reserved;
+    uint64_t content_hash;       ///< FNV-1a over every byte after the header
+    uint64_t points_offset;
+    uint64_t matrix_offset;
+    uint64_t candidates_offset;  ///< Offset of the CandidateSetEntry directory
+    uint64_t source_size;        ///< Size in bytes of the CSV the bundle was built from
+    uint64_t source_hash;        ///< FNV-1a over the bytes of that CSV
+};
+
+struct InstanceBundle::CandidateSetEntry {
+    uint32_t k;
+    uint32_t reserved;
+    uint64_t neighbors_offset;
+    uint64_t distances_offset;
+};
+
+// Start of anonymous namespace
+// Functions inside here are local to this file only and are not exported.
+namespace {
+
+const char MAGIC[8] = {'T', 'S', 'P', 'B', 'N', 'D', 'L', '\0'};
+const uint32_t BYTE_ORDER_MARK = 0x01020304u;
+
+const uint64_t FNV_OFFSET_BASIS = 1469598103934665603ull;
+const uint64_t FNV_PRIME = 1099511628211ull;
+
+uint64_t fnv1a(uint64_t hash, const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+uint64_t align_up(uint64_t offset) {
+    return (offset + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE * CACHE_LINE_SIZE;
+}
+
+// Sequential writer that hashes everything it writes and pads sections to cache lines
+class SectionWriter {
+public:
+    explicit SectionWriter(std::ofstream& out) : out(out), offset(0), hash(FNV_OFFSET_BASIS) {}
+
+    void write(const void* data, size_t size) {
+        out.write(static_cast<const char*>(data), size);
+        hash = fnv1a(hash, data, size);
+        offset += size;
+    }
+
+    void pad_to_alignment() {
+        static const char zeros[CACHE_LINE_SIZE] = {};
+        write(zeros, align_up(offset) - offset);
+    }
+
+    std::ofstream& out;
+    uint64_t offset;
+    uint64_t hash;
+};
+
+}
+
+bool InstanceBundle::open(const std::string& filename, bool verify_hash) {
+    header = nullptr;
+    candidate_sets = nullptr;
+    file = std::make_shared<MappedFile>();
+    if (!file->open(filename)) {
+        std::cerr << "Error: could not open bundle " << filename << "\n";
+        return false;
+    }
+
+    const size_t size = file->size();
+    const char* base = file->data();
+    if (size < sizeof(Header)) {
+        std::cerr << "Error: " << filename << " is too small to be a bundle\n";
+        return false;
+    }
+
+    const Header* h = reinterpret_cast<const Header*>(base);
+    if (std::memcmp(h->magic, MAGIC, sizeof(MAGIC)) != 0) {
+        std::cerr << "Error: " << filename << " is not an instance bundle\n";
+        return false;
+    }
+    if (h->version != FORMAT_VERSION || h->byte_order != BYTE_ORDER_MARK) {
+        std::cerr << "Error: " << filename << " has an unsupported version or byte order\n";
+        return false;
+    }
+
+    // Every section must lie inside the file and the matrix must keep its cache-line alignment
+    const uint64_t n = h->num_points;
+    const uint64_t directory_end = h->candidates_offset + h->num_candidate_sets * sizeof(CandidateSetEntry);
+    if (h->row_stride < n ||
+        h->points_offset + n * sizeof(PointData) > size ||
+        h->matrix_offset % CACHE_LINE_SIZE != 0 ||
+        h->matrix_offset + n * h->row_stride * sizeof(int) > size ||
+        directory_end > size) {
+        std::cerr << "Error: " << filename << " is truncated or corrupt\n";
+        return false;
+    }
+    const CandidateSetEntry* sets = reinterpret_cast<const CandidateSetEntry*>(base + h->candidates_offset);
+    for (uint32_t s = 0; s < h->num_candidate_sets; ++s) {
+        const uint64_t list_bytes = n * sets[s].k * sizeof(int);
+        if (sets[s].k == 0 || sets[s].k >= n ||
+            sets[s].neighbors_offset % sizeof(int) != 0 ||
+            sets[s].neighbors_offset + list_bytes > size || sets[s].distances_offset + list_bytes > size) {
+            std::cerr << "Error: " << filename << " is truncated or corrupt\n";
+            return false;
+        }
+        // Neighbour ids index per-node arrays everywhere, so one bad id would read out of bounds later
+        const int* neighbors = reinterpret_cast<const int*>(base + sets[s].neighbors_offset);
+        for (uint64_t i = 0; i < n * sets[s].k; ++i) {
+            if (neighbors[i] < 0 || static_cast<uint64_t>(neighbors[i]) >= n) {
+                std::cerr << "Error: " << filename << " has a candidate neighbour id out of range\n";
+                return false;
+            }
+        }
+    }
+
+    if (verify_hash && fnv1a(FNV_OFFSET_BASIS, base + sizeof(Header), size - sizeof(Header)) != h->content_hash) {
+        std::cerr << "Error: content hash mismatch in " << filename << "\n";
+        return false;
+    }
+
+    header = h;
+    candidate_sets = sets;
+    return true;
+}
+
+int InstanceBundle::num_points() const {
+    return static_cast<int>(header->num_points);
+}
+
+const PointData* InstanceBundle::points() const {
+    return reinterpret_cast<const PointData*>(file->data() + header->points_offset);
+}
+
+const int* InstanceBundle::distance_matrix() const {
+    return reinterpret_cast<const int*>(file->data() + header->matrix_offset);
+}
+
+size_t InstanceBundle::row_stride() const {
+    return header->row_stride;
+}
+
+uint64_t InstanceBundle::content_hash() const {
+    return header->content_hash;
+}
+
+bool InstanceBundle::matches_source(const std::string& source_filename) const {
+    MappedFile source;
+    if (!source.open(source_filename) || source.size() != header->source_size) {
+        return false;
+    }
+    return fnv1a(FNV_OFFSET_BASIS, source.data(), source.size()) == header->source_hash;
+}
+
+int InstanceBundle::num_candidate_sets() const {
+    return static_cast<int>(header->num_candidate_sets);
+}
+
+int InstanceBundle::candidate_k(int set) const {
+    return static_cast<int>(candidate_sets[set].k);
+}
+
+const int* InstanceBundle::candidate_neighbors(int set) const {
+    return reinterpret_cast<const int*>(file->data() + candidate_sets[set].neighbors_offset);
+}
+
+const int* InstanceBundle::candidate_distances(int set) const {
+    return reinterpret_cast<const int*>(file->data() + candidate_sets[set].distances_offset);
+}
+
+bool write_instance_bundle(const std::string& filename, const TSPProblem& problem, const std::vector<int>& candidate_ks,
+                           const std::string& source_filename) {
+    if (!problem.has_distance_matrix()) {
+        std::cerr << "Error: bundles can only be written for problems with a distance matrix\n";
+        return false;
+    }
+    MappedFile source;
+    if (!source.open(source_filename)) {
+        std::cerr << "Error: could not read source " << source_filename << "\n";
+        return false;
+    }
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "Error: could not create bundle " << filename << "\n";
+        return false;
+    }
+
+    const uint64_t n = problem.get_num_points();
+    const uint64_t row_stride = problem.get_row_stride();
+
+    // Resolve the candidate lists first so the whole layout is known up front
+    std::vector<const CandidateLists*> lists;
+    for (int k : candidate_ks) {
+        lists.push_back(&problem.get_candidates(k));
+    }
+
+    InstanceBundle::Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = InstanceBundle::FORMAT_VERSION;
+    header.byte_order = BYTE_ORDER_MARK;
+    header.num_points = static_cast<uint32_t>(n);
+    header.row_stride = static_cast<uint32_t>(row_stride);
+    header.num_candidate_sets = static_cast<uint32_t>(lists.size());
+    header.source_size = source.size();
+    header.source_hash = fnv1a(FNV_OFFSET_BASIS, source.data(), source.size());
+
+    header.points_offset = align_up(sizeof(header));
+    header.matrix_offset = align_up(header.points_offset + n * sizeof(PointData));
+    header.candidates_offset = align_up(header.matrix_offset + n * row_stride * sizeof(int));
+
+    std::vector<InstanceBundle::CandidateSetEntry> directory(lists.size());
+    uint64_t offset = align_up(header.candidates_offset + directory.size() * sizeof(InstanceBundle::CandidateSetEntry));
+    for (size_t s = 0; s < lists.size(); ++s) {
+        const uint64_t list_bytes = lists[s]->neighbors.size() * sizeof(int);
+        directory[s].k = static_cast<uint32_t>(lists[s]->k);
+        directory[s].reserved = 0;
+        directory[s].neighbors_offset = offset;
+        directory[s].distances_offset = align_up(offset + list_bytes);
+        offset = align_up(directory[s].distances_offset + list_bytes);
+    }
+
+    // The header is written last, once the content hash is known
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    SectionWriter writer(out);
+    writer.offset = sizeof(header);
+
+    writer.pad_to_alignment();
+    writer.write(problem.get_points().data(), n * sizeof(PointData));
+    writer.pad_to_alignment();
+    for (uint64_t i = 0; i < n; ++i) {
+        writer.write(problem.get_distance_row(static_cast<int>(i)), row_stride * sizeof(int));
+    }
+    writer.pad_to_alignment();
+    writer.write(directory.data(), directory.size() * sizeof(InstanceBundle::CandidateSetEntry));
+    for (const CandidateLists* list : lists) {
+        writer.pad_to_alignment();
+        writer.write(list->neighbors.data(), list->neighbors.size() * sizeof(int));
+        writer.pad_to_alignment();
+        writer.write(list->distances.data(), list->distances.size() * sizeof(int));
+    }
+    writer.pad_to_alignment();
+
+    header.content_hash = writer.hash;
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.close();
+
+    if (!out) {
+        std::cerr << "Error: failed to write bundle " << filename << "\n";
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,94 @@
+#ifndef INSTANCE_BUNDLE_H
+#define INSTANCE_BUNDLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "point_data.h"
+#include "mapped_file.h"
+
+class TSPProblem;
+
+/**
+ * @brief Precomputed instance bundle: a binary cache of everything TSPProblem derives from a CSV.
+ *
+ * Layout (native byte order, every section aligned to 64 bytes):
+ *   header     magic "TSPBNDL", format version, byte-order mark, point count, matrix row stride,
+ *              number of candidate sets, content hash, section offsets and the size and
+ *              FNV-1a hash of the source CSV
+ *   points     n PointData records
+ *   matrix     n rows of `row_stride` ints, padded exactly like TSPProblem's own matrix
+ *   candidates directory of (K, offset) entries followed by, per K, n * K neighbour ids
+ *              and n * K candidate edge distances
+ *
+ * The content hash is a 64-bit FNV-1a over every byte after the header. Opening a bundle
+ * validates the header, the section bounds, every candidate K (0 < K < n) and every candidate
+ * neighbour id (O(sum of n * K)); the hash is checked on request. Callers that also hold the
+ * CSV check matches_source before trusting the bundle, so an edited CSV is never shadowed by
+ * a stale bundle. The matrix is used straight from the memory mapping, so no preprocessing is
+ * repeated.
+ */
+class InstanceBundle {
+public:
+    /// Current format version; bundles with any other version are rejected.
+    static const uint32_t FORMAT_VERSION = 2;
+
+    /**
+     * @brief Opens and validates a bundle file.
+     * @param filename Path of the bundle.
+     * @param verify_hash Whether to recompute the content hash (reads the whole file).
+     * @return true on success; on failure a reason is printed to std::cerr.
+     */
+    bool open(const std::string& filename, bool verify_hash = false);
+
+    int num_points() const;
+    const PointData* points() const;
+    const int* distance_matrix() const;
+    size_t row_stride() const;
+    uint64_t content_hash() const;
+
+    /**
+     * @brief Checks that the bundle was built from the current contents of a CSV.
+     * Compares the file size first and then the FNV-1a hash of its bytes (one read of the CSV,
+     * far cheaper than parsing it and rebuilding the matrix).
+     * @param source_filename Path of the CSV the bundle stands in for.
+     * @return true if the CSV has the size and hash recorded when the bundle was written.
+     */
+    bool matches_source(const std::string& source_filename) const;
+
+    /// Number of candidate-list sets stored in the bundle.
+    int num_candidate_sets() const;
+    /// K of the given candidate set.
+    int candidate_k(int set) const;
+    /// Flattened neighbour ids of the given set (n * K entries).
+    const int* candidate_neighbors(int set) const;
+    /// Flattened candidate edge distances of the given set (n * K entries).
+    const int* candidate_distances(int set) const;
+
+    /// Shared owner of the mapping; keeps the pointers above valid while held.
+    std::shared_ptr<const MappedFile> mapping() const { return file; }
+
+private:
+    struct Header;
+    struct CandidateSetEntry;
+    friend bool write_instance_bundle(const std::string&, const TSPProblem&, const std::vector<int>&, const std::string&);
+
+    std::shared_ptr<MappedFile> file;
+    const Header* header = nullptr;
+    const CandidateSetEntry* candidate_sets = nullptr;
+};
+
+/**
+ * @brief Writes a bundle for a problem instance.
+ * @param filename Output path.
+ * @param problem The problem (must store a full distance matrix).
+ * @param candidate_ks The K values whose candidate lists are stored.
+ * @param source_filename The CSV the problem was loaded from; its size and hash are recorded.
+ * @return true on success; on failure a reason is printed to std::cerr.
+ */
+bool write_instance_bundle(const std::string& filename, const TSPProblem& problem, const std::vector<int>& candidate_ks,
+                           const std::string& source_filename);
+
+#endif // INSTANCE_BUNDLE_H
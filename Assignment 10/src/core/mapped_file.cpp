@@ -0,0 +1,107 @@
+#include "mapped_file.h"
+
+#include <fstream>
+#include <utility>
+
+#if !defined(_WIN32)
+#define MAPPED_FILE_USE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile() : data_(nullptr), size_(0), mapped_(false) {}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(other.data_), size_(other.size_), mapped_(other.mapped_), buffer_(std::move(other.buffer_)) {
+    if (!mapped_ && !buffer_.empty()) {
+        data_ = buffer_.data();
+    }
+    other.data_ = nullptr;
+    other.size_ = 0;
+    other.mapped_ = false;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        data_ = other.data_;
+        size_ = other.size_;
+        mapped_ = other.mapped_;
+        buffer_ = std::move(other.buffer_);
+        if (!mapped_ && !buffer_.empty()) {
+            data_ = buffer_.data();
+        }
+        other.data_ = nullptr;
+        other.size_ = 0;
+        other.mapped_ = false;
+    }
+    return *this;
+}
+
+bool MappedFile::open(const std::string& filename) {
+    close();
+
+#ifdef MAPPED_FILE_USE_MMAP
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        return false;
+    }
+    size_ = static_cast<size_t>(info.st_size);
+    if (size_ > 0) {
+        void* address = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address == MAP_FAILED) {
+            // Some file systems do not support mapping; read the file instead
+            ::close(fd);
+            size_ = 0;
+            return read_buffered(filename);
+        }
+        data_ = static_cast<const char*>(address);
+        mapped_ = true;
+    }
+    // The mapping keeps its own reference to the file
+    ::close(fd);
+    return true;
+#else
+    return read_buffered(filename);
+#endif
+}
+
+bool MappedFile::read_buffered(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return false;
+    }
+    size_ = static_cast<size_t>(file.tellg());
+    buffer_.resize(size_);
+    file.seekg(0);
+    if (size_ > 0 && !file.read(buffer_.data(), size_)) {
+        buffer_.clear();
+        size_ = 0;
+        return false;
+    }
+    data_ = size_ > 0 ? buffer_.data() : nullptr;
+    return true;
+}
+
+void MappedFile::close() {
+#ifdef MAPPED_FILE_USE_MMAP
+    if (mapped_) {
+        munmap(const_cast<char*>(data_), size_);
+    }
+#endif
+    buffer_.clear();
+    data_ = nullptr;
+    size_ = 0;
+    mapped_ = false;
+}
@@ -0,0 +1,56 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Read-only view of a whole file.
+ *
+ * On POSIX systems the file is memory-mapped, so opening it costs O(1) regardless of its
+ * size and pages are only read when touched. Elsewhere, or when mmap fails, the contents are
+ * read into an owned buffer. The mapping lives as long as the object; it is movable but not copyable.
+ */
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Maps a file, releasing any previously mapped one.
+     * @param filename Path of the file.
+     * @return true on success, false if the file could not be opened or read.
+     */
+    bool open(const std::string& filename);
+
+    /**
+     * @brief Unmaps the file (no-op if nothing is mapped).
+     */
+    void close();
+
+    /**
+     * @brief Retrieves the first byte of the file (null for an empty or unmapped file).
+     */
+    const char* data() const { return data_; }
+
+    /**
+     * @brief Retrieves the file size in bytes.
+     */
+    size_t size() const { return size_; }
+
+private:
+    const char* data_;
+    size_t size_;
+    bool mapped_;              ///< Whether data_ must be released with munmap.
+    std::vector<char> buffer_; ///< Owned copy when memory mapping is unavailable.
+
+    /// Reads the whole file into buffer_ (the fallback when it cannot be mapped).
+    bool read_buffered(const std::string& filename);
+};
+
+#endif // MAPPED_FILE_H
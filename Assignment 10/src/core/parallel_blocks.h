@@ -0,0 +1,45 @@
+#ifndef PARALLEL_BLOCKS_H
+#define PARALLEL_BLOCKS_H
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Runs `block(first, last)` over [0, count) split into contiguous blocks, one per thread.
+ *
+ * Threads are started for the call and joined before it returns; the calling thread runs the
+ * first block itself. Starting and joining a thread costs tens of microseconds, so a thread is
+ * only started for at least `min_per_thread` items: the thread count is capped at
+ * count / min_per_thread (and is always at least one). Contiguous blocks also keep the output
+ * of different threads in different cache lines.
+ *
+ * @param count Number of items.
+ * @param min_per_thread Smallest number of items worth a thread of its own (at least 1).
+ * @param num_threads Maximum number of threads, 0 = one per hardware thread.
+ * @param block Callable invoked as block(size_t first, size_t last) for every block.
+ */
+template <typename BlockFunc>
+void parallel_for_blocks(size_t count, size_t min_per_thread, int num_threads, BlockFunc block) {
+    if (num_threads <= 0) {
+        num_threads = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    const size_t useful_threads = count / std::max<size_t>(min_per_thread, 1);
+    const size_t threads = std::max<size_t>(1, std::min(static_cast<size_t>(std::max(num_threads, 1)), useful_threads));
+
+    auto run_block = [&](size_t thread_index) {
+        block(count * thread_index / threads, count * (thread_index + 1) / threads);
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t t = 1; t < threads; ++t) {
+        workers.emplace_back(run_block, t);
+    }
+    run_block(0);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+#endif // PARALLEL_BLOCKS_H
@@ -0,0 +1,53 @@
+#ifndef SPATIAL_INDEX_H
+#define SPATIAL_INDEX_H
+
+#include <vector>
+#include <utility>
+#include "point_data.h"
+
+/**
+ * @brief Static k-d tree over point coordinates for K-best neighbour queries.
+ *
+ * The score of a neighbour j of node i is `round(euclidean(i, j)) + cost(j)`, i.e. the same
+ * metric used for candidate lists. Every tree node stores the bounding box and the minimum
+ * node cost of its subtree, so whole subtrees whose lower bound cannot beat the current K-th
+ * best score are skipped without scoring their points. Building takes O(n log n); a query
+ * touches roughly O(log n + K) leaves on evenly spread instances and never builds an n-sized list.
+ */
+class SpatialIndex {
+public:
+    /**
+     * @brief Builds the tree.
+     * @param points The points of the instance (ids must be 0..n-1 and equal to their index).
+     */
+    explicit SpatialIndex(const std::vector<PointData>& points);
+
+    /**
+     * @brief Finds the K best neighbours of a node.
+     * The result equals taking the first K entries of all other nodes sorted ascending by
+     * (score, id), so ties are resolved exactly like a full sort would resolve them.
+     * @param query The node id to search around (excluded from the result).
+     * @param K Number of neighbours to return (fewer if the instance is smaller).
+     * @param out Output vector, overwritten with the neighbour ids in ascending score order.
+     */
+    void k_best_neighbors(int query, int K, std::vector<int>& out) const;
+
+private:
+    struct Node {
+        int min_x, max_x, min_y, max_y; ///< Bounding box of the subtree.
+        int min_cost;                   ///< Smallest node cost in the subtree.
+        int begin, end;                 ///< Slot range [begin, end) covered by the subtree.
+        int left, right;                ///< Child node indices, -1 for leaves.
+    };
+
+    // Point data permuted into tree order so that each leaf is a contiguous slot range
+    std::vector<int> slot_x, slot_y, slot_cost, slot_id;
+    std::vector<int> slot_of_id; ///< Position of every node id in the slot arrays.
+    std::vector<Node> nodes;     ///< Tree nodes, the root is nodes[0].
+
+    int build(std::vector<int>& ids, int begin, int end, const std::vector<PointData>& points);
+    void search(int node_index, int query_x, int query_y, int query_id, int K,
+                std::vector<std::pair<int, int>>& heap) const;
+};
+
+#endif // SPATIAL_INDEX_H
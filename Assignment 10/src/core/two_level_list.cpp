@@ -0,0 +1,258 @@
+#include "two_level_list.h"
+
+#include <algorithm>
+#include <cmath>
+
+TwoLevelList::TwoLevelList(const std::vector<int>& tour, int num_nodes)
+    : num_nodes(num_nodes), tour_size(0), group_size(1), num_segments(0), max_segments(0) {
+    build(tour);
+}
+
+void TwoLevelList::build(const std::vector<int>& tour) {
+    tour_size = static_cast<int>(tour.size());
+    group_size = std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(tour_size)))));
+    num_segments = (tour_size + group_size - 1) / group_size;
+    // Every reversal splits at most two segments; rebuilding once the count has doubled
+    // costs O(m) every O(sqrt(m)) moves
+    max_segments = 2 * num_segments + 2;
+
+    parent.assign(num_nodes, -1);
+    sequence.assign(num_nodes, 0);
+    link_next.assign(num_nodes, -1);
+    link_prev.assign(num_nodes, -1);
+
+    reversed.assign(num_segments, 0);
+    segment_first.assign(num_segments, -1);
+    segment_last.assign(num_segments, -1);
+    segment_next.assign(num_segments, 0);
+    segment_prev.assign(num_segments, 0);
+    rank.assign(num_segments, 0);
+
+    for (int s = 0; s < num_segments; ++s) {
+        const int begin = s * group_size;
+        const int end = std::min(tour_size, begin + group_size);
+        for (int i = begin; i < end; ++i) {
+            const int node = tour[i];
+            parent[node] = s;
+            sequence[node] = i - begin;
+            link_prev[node] = (i > begin) ? tour[i - 1] : -1;
+            link_next[node] = (i + 1 < end) ? tour[i + 1] : -1;
+        }
+        segment_first[s] = tour[begin];
+        segment_last[s] = tour[end - 1];
+        segment_next[s] = (s + 1) % num_segments;
+        segment_prev[s] = (s + num_segments - 1) % num_segments;
+        rank[s] = s;
+    }
+}
+
+bool TwoLevelList::between(int a, int b, int c) const {
+    const int rank_a = rank[parent[a]], rank_b = rank[parent[b]], rank_c = rank[parent[c]];
+    const long long seq_a = oriented_sequence(a), seq_b = oriented_sequence(b), seq_c = oriented_sequence(c);
+
+    auto not_after = [](int r1, long long s1, int r2, long long s2) {
+        return r1 < r2 || (r1 == r2 && s1 <= s2);
+    };
+
+    if (not_after(rank_a, seq_a, rank_c, seq_c)) {
+        return not_after(rank_a, seq_a, rank_b, seq_b) && not_after(rank_b, seq_b, rank_c, seq_c);
+    }
+    // The path a..c wraps past the end of the ring numbering
+    return not_after(rank_a, seq_a, rank_b, seq_b) || not_after(rank_b, seq_b, rank_c, seq_c);
+}
+
+int TwoLevelList::segments_on_path(int a, int b) const {
+    const int sa = parent[a];
+    const int sb = parent[b];
+    if (sa == sb) {
+        return (oriented_sequence(a) <= oriented_sequence(b)) ? 1 : num_segments + 1;
+    }
+    return (rank[sb] - rank[sa] + num_segments) % num_segments + 1;
+}
+
+void TwoLevelList::two_opt_move(int a, int b, int c, int d) {
+    // Reversing b..c or d..a yields the same cycle; take the one spanning fewer segments
+    if (segments_on_path(b, c) <= segments_on_path(d, a)) {
+        reverse_path(b, c);
+    } else {
+        reverse_path(d, a);
+    }
+
+    if (num_segments > max_segments) {
+        build(to_vector(segment_head(0)));
+    }
+}
+
+void TwoLevelList::replace(int old_node, int new_node) {
+    const int s = parent[old_node];
+    parent[new_node] = s;
+    sequence[new_node] = sequence[old_node];
+    link_prev[new_node] = link_prev[old_node];
+    link_next[new_node] = link_next[old_node];
+
+    if (link_prev[old_node] != -1) link_next[link_prev[old_node]] = new_node;
+    else segment_first[s] = new_node;
+    if (link_next[old_node] != -1) link_prev[link_next[old_node]] = new_node;
+    else segment_last[s] = new_node;
+
+    parent[old_node] = -1;
+    link_prev[old_node] = -1;
+    link_next[old_node] = -1;
+}
+
+std::vector<int> TwoLevelList::to_vector(int start) const {
+    std::vector<int> tour;
+    tour.reserve(tour_size);
+    int node = start;
+    for (int i = 0; i < tour_size; ++i) {
+        tour.push_back(node);
+        node = next(node);
+    }
+    return tour;
+}
+
+void TwoLevelList::reverse_path(int from, int to) {
+    if (from == to) {
+        return;
+    }
+    if (parent[from] == parent[to] && oriented_sequence(from) < oriented_sequence(to)) {
+        reverse_inside_segment(from, to);
+        return;
+    }
+
+    // Cut the path out as a run of whole segments
+    split_before(from);
+    split_before(next(to));
+
+    std::vector<int> path_segments;
+    for (int s = parent[from]; ; s = segment_next[s]) {
+        path_segments.push_back(s);
+        if (s == parent[to]) break;
+    }
+    const int k = static_cast<int>(path_segments.size());
+
+    std::vector<int> old_ranks(k);
+    for (int i = 0; i < k; ++i) {
+        old_ranks[i] = rank[path_segments[i]];
+        reversed[path_segments[i]] ^= 1;
+    }
+
+    // Reverse the order of the run on the ring; it keeps the ranks it occupied
+    const int before = segment_prev[path_segments.front()];
+    const int after = segment_next[path_segments.back()];
+    const bool whole_ring = (k == num_segments);
+    for (int i = 0; i < k; ++i) {
+        const int s = path_segments[k - 1 - i];
+        rank[s] = old_ranks[i];
+        if (i + 1 < k) {
+            segment_next[s] = path_segments[k - 2 - i];
+            segment_prev[path_segments[k - 2 - i]] = s;
+        }
+    }
+    const int new_first = path_segments.back();
+    const int new_last = path_segments.front();
+    if (whole_ring) {
+        segment_next[new_last] = new_first;
+        segment_prev[new_first] = new_last;
+    } else {
+        segment_next[before] = new_first;
+        segment_prev[new_first] = before;
+        segment_next[new_last] = after;
+        segment_prev[after] = new_last;
+    }
+}
+
+void TwoLevelList::reverse_inside_segment(int from, int to) {
+    const int s = parent[from];
+    // u..v is the same path in the segment's internal order
+    const int u = reversed[s] ? to : from;
+    const int v = reversed[s] ? from : to;
+    const int outer_prev = link_prev[u];
+    const int outer_next = link_next[v];
+
+    if (outer_prev == -1 && outer_next == -1) {
+        reversed[s] ^= 1;
+        return;
+    }
+
+    std::vector<int> nodes;
+    for (int node = u; ; node = link_next[node]) {
+        nodes.push_back(node);
+        if (node == v) break;
+    }
+    const int m = static_cast<int>(nodes.size());
+    const int first_sequence = sequence[u];
+
+    // Relink in reverse order, reusing the same (consecutive) sequence numbers
+    for (int i = 0; i < m; ++i) {
+        const int node = nodes[m - 1 - i];
+        sequence[node] = first_sequence + i;
+        link_prev[node] = (i > 0) ? nodes[m - i] : outer_prev;
+        link_next[node] = (i + 1 < m) ? nodes[m - 2 - i] : outer_next;
+    }
+    if (outer_prev != -1) link_next[outer_prev] = v;
+    else segment_first[s] = v;
+    if (outer_next != -1) link_prev[outer_next] = u;
+    else segment_last[s] = u;
+}
+
+void TwoLevelList::split_before(int node) {
+    const int s = parent[node];
+    if (node == segment_head(s)) {
+        return;
+    }
+
+    // Cut the internal list between x and y; the tour-order boundary falls in front of `node`
+    const int x = reversed[s] ? node : link_prev[node];
+    const int y = reversed[s] ? link_next[node] : node;
+
+    // Sequence numbers inside a segment are consecutive, so the part sizes are differences
+    const int left_count = sequence[x] - sequence[segment_first[s]] + 1;
+    const int right_count = sequence[segment_last[s]] - sequence[y] + 1;
+    const bool move_left = left_count <= right_count;
+
+    const int t = static_cast<int>(reversed.size());
+    reversed.push_back(reversed[s]);
+    segment_first.push_back(move_left ? segment_first[s] : y);
+    segment_last.push_back(move_left ? x : segment_last[s]);
+    segment_next.push_back(0);
+    segment_prev.push_back(0);
+    rank.push_back(0);
+    ++num_segments;
+
+    if (move_left) {
+        segment_first[s] = y;
+    } else {
+        segment_last[s] = x;
+    }
+    link_next[x] = -1;
+    link_prev[y] = -1;
+    for (int moved = segment_first[t]; moved != -1; moved = link_next[moved]) {
+        parent[moved] = t;
+    }
+
+    // The left internal part comes first in tour order unless the segment is reversed
+    const bool insert_before = (move_left != static_cast<bool>(reversed[s]));
+    if (insert_before) {
+        const int p = segment_prev[s];
+        segment_next[p] = t;
+        segment_prev[t] = p;
+        segment_next[t] = s;
+        segment_prev[s] = t;
+    } else {
+        const int n = segment_next[s];
+        segment_next[s] = t;
+        segment_prev[t] = s;
+        segment_next[t] = n;
+        segment_prev[n] = t;
+    }
+    renumber_ranks(s);
+}
+
+void TwoLevelList::renumber_ranks(int start_segment) {
+    int s = start_segment;
+    for (int r = 0; r < num_segments; ++r) {
+        rank[s] = r;
+        s = segment_next[s];
+    }
+}
@@ -0,0 +1,112 @@
+#ifndef TWO_LEVEL_LIST_H
+#define TWO_LEVEL_LIST_H
+
+#include <vector>
+
+/**
+ * @brief Tour stored as a two-level doubly-linked list.
+ *
+ * The tour is cut into O(sqrt(m)) segments kept on a circular list. Every segment carries a
+ * reversal bit, and every node stores its segment, a sequence number inside the segment and
+ * its neighbours in the segment's internal order. This gives:
+ *   - next / prev / between / contains in O(1),
+ *   - 2-opt reversal in O(sqrt(m)): at most two segments are split at the path ends, and the
+ *     whole segments in between are reversed by flipping their bits and their order,
+ *   - node replacement (exchanging a tour node for an unused one) in O(1).
+ *
+ * Splits only ever add segments; once there are too many the list is rebuilt from scratch,
+ * which keeps the amortised cost of a reversal at O(sqrt(m)).
+ * Node ids range over the whole problem (0..num_nodes-1); only some of them are in the tour.
+ * The traversal direction of the tour is not preserved by reversals.
+ */
+class TwoLevelList {
+public:
+    /**
+     * @brief Builds the list for a tour.
+     * @param tour The tour as a sequence of node ids.
+     * @param num_nodes Total number of nodes in the problem (ids must be below this).
+     */
+    TwoLevelList(const std::vector<int>& tour, int num_nodes);
+
+    /// Number of nodes in the tour.
+    int size() const { return tour_size; }
+
+    /// Whether the node is currently in the tour.
+    bool contains(int node) const { return parent[node] != -1; }
+
+    /// Successor of a tour node.
+    int next(int node) const {
+        const int s = parent[node];
+        if (node == segment_tail(s)) return segment_head(segment_next[s]);
+        return reversed[s] ? link_prev[node] : link_next[node];
+    }
+
+    /// Predecessor of a tour node.
+    int prev(int node) const {
+        const int s = parent[node];
+        if (node == segment_head(s)) return segment_tail(segment_prev[s]);
+        return reversed[s] ? link_next[node] : link_prev[node];
+    }
+
+    /**
+     * @brief Whether b lies on the path that goes forward from a to c (both ends inclusive).
+     */
+    bool between(int a, int b, int c) const;
+
+    /**
+     * @brief Applies the 2-opt move that replaces edges (a, b) and (c, d) with (a, c) and (b, d).
+     * Requires b == next(a) and d == next(c). The shorter of the two equivalent paths (b..c or
+     * d..a) is reversed.
+     */
+    void two_opt_move(int a, int b, int c, int d);
+
+    /**
+     * @brief Replaces a tour node with a node that is not in the tour, keeping its position.
+     */
+    void replace(int old_node, int new_node);
+
+    /**
+     * @brief Returns the tour as a vector, starting at `start` (which must be in the tour).
+     */
+    std::vector<int> to_vector(int start) const;
+
+private:
+    int segment_head(int s) const { return reversed[s] ? segment_last[s] : segment_first[s]; }
+    int segment_tail(int s) const { return reversed[s] ? segment_first[s] : segment_last[s]; }
+
+    // Sequence number of a node along the tour direction inside its segment
+    long long oriented_sequence(int node) const {
+        return reversed[parent[node]] ? -static_cast<long long>(sequence[node]) : sequence[node];
+    }
+
+    // Number of segments on the path from the segment of a to the segment of b (inclusive)
+    int segments_on_path(int a, int b) const;
+
+    void build(const std::vector<int>& tour);
+    void reverse_path(int from, int to);
+    void reverse_inside_segment(int from, int to);
+    void split_before(int node);
+    void renumber_ranks(int start_segment);
+
+    int num_nodes;
+    int tour_size;
+    int group_size;
+
+    // Per node
+    std::vector<int> parent;     ///< Segment of the node, -1 when the node is not in the tour
+    std::vector<int> sequence;   ///< Increasing along the segment's internal order
+    std::vector<int> link_next;  ///< Internal-order neighbours inside the segment (-1 at the ends)
+    std::vector<int> link_prev;
+
+    // Per segment
+    std::vector<char> reversed;
+    std::vector<int> segment_first;  ///< First node in internal order
+    std::vector<int> segment_last;   ///< Last node in internal order
+    std::vector<int> segment_next;   ///< Ring of segments in tour direction
+    std::vector<int> segment_prev;
+    std::vector<int> rank;           ///< Cyclic position of the segment on the ring
+    int num_segments;
+    int max_segments;
+};
+
+#endif // TWO_LEVEL_LIST_H
@@ -5,6 +5,7 @@
 #include <fstream>
 #include <iomanip>
 #include <sstream>
+#include <memory>
 
 #include "core/data_loader.h"
 #include "core/point_data.h"
@@ -12,6 +13,7 @@
 #include "core/stagetimer.h"
 #include "core/TSPProblem.h"
 #include "core/experiment_runner.h"
+#include "core/instance_bundle.h"
 
 #include "algorithms/constructors/random_solution.h"
 #include "algorithms/constructors/greedy_weighted_regret_constructor.h"
@@ -49,18 +51,47 @@ void generate_grid_configurations(
     }
 }
 
+// Instances above this size do not get an n x n distance matrix (it would take n^2 * 4 bytes);
+// distances are then computed from the coordinates on demand
+const size_t MAX_MATRIX_POINTS = 20000;
+
+// Loads an instance, preferring its precomputed bundle (same path with a .bundle extension) if requested
+// and built from the current contents of the CSV
+std::unique_ptr<TSPProblem> load_problem(const std::string& filename, bool use_bundle) {
+    if (use_bundle) {
+        std::string bundle_filename = filename.substr(0, filename.rfind('.')) + ".bundle";
+        InstanceBundle bundle;
+        if (bundle.open(bundle_filename)) {
+            if (bundle.matches_source(filename)) {
+                std::cout << "Using precomputed bundle " << bundle_filename << std::endl;
+                return std::unique_ptr<TSPProblem>(new TSPProblem(bundle));
+            }
+            std::cout << bundle_filename << " is stale (" << filename << " changed since it was built)" << std::endl;
+        }
+        std::cout << "Falling back to " << filename << std::endl;
+    }
+
+    std::vector<PointData> data;
+    if (!load_data(filename, data)) {
+        return nullptr;
+    }
+
+    DistanceMode distance_mode = data.size() > MAX_MATRIX_POINTS ? DistanceMode::ON_DEMAND : DistanceMode::MATRIX;
+    // Huge pages only apply to matrices of 2 MB or more (about 700 points); smaller ones are unaffected
+    return std::unique_ptr<TSPProblem>(new TSPProblem(data, distance_mode, true));
+}
+
 // Function to process a single instance of the problem
-void process_instance(const std::string& filename, const std::string& instance_name, json& results_json, int time_limit_ms) {
+void process_instance(const std::string& filename, const std::string& instance_name, json& results_json, int time_limit_ms, bool use_bundle) {
     std::cout << "=================================================" << std::endl;
     std::cout << "Processing instance: " << filename << std::endl;
     std::cout << "=================================================" << std::endl;
 
-    std::vector<PointData> data;
-    if (!load_data(filename, data)) {
+    std::unique_ptr<TSPProblem> problem = load_problem(filename, use_bundle);
+    if (!problem) {
         return;
     }
-
-    TSPProblem problem_instance = TSPProblem(data);
+    TSPProblem& problem_instance = *problem;
     const int num_runs = 20; // Changed to 20 as per assignment
 
     StageTimer timer;
@@ -79,6 +110,9 @@ void process_instance(const std::string& filename, const std::string& instance_n
         {"stagnation_step", {100.0}},
         {"k_candidates", {-1.0}},
         {"max_stagnation_iterations", {-1.0}},
+        {"use_lin_kernighan", {0.0}},              // 1: lin_kernighan_search instead of local_search
+        {"use_parallel_steepest", {0.0}},          // 1: threaded steepest search (only with k_candidates = -1)
+        {"use_multi_move", {0.0}},                 // 1: batched steepest search (only with k_candidates = -1)
         {"initial_solution_builder", {1.0}}, // 0: random, 1: greedy_weighted_regret
         {"regret_k_candidates", {5.0}}     // for greedy regret
     };
@@ -130,6 +164,9 @@ void process_instance(const std::string& filename, const std::string& instance_n
             int stag_step = (int)config.at("stagnation_step");
             int k = (int)config.at("k_candidates");
             int max_stag_iter = (int)config.at("max_stagnation_iterations");
+            bool use_lk = (config.at("use_lin_kernighan") > 0.5);
+            bool use_parallel = (config.at("use_parallel_steepest") > 0.5);
+            bool use_multi_move = (config.at("use_multi_move") > 0.5);
             
             int builder_type = (int)config.at("initial_solution_builder");
             int regret_k = (int)config.at("regret_k_candidates");
@@ -164,7 +201,10 @@ void process_instance(const std::string& filename, const std::string& instance_n
                 use_adaptive_mut,
                 stag_step,
                 k,
-                max_stag_iter
+                max_stag_iter,
+                use_lk,
+                use_parallel,
+                use_multi_move
             );
             timer.end_stage();
             return result;
@@ -176,6 +216,7 @@ void process_instance(const std::string& filename, const std::string& instance_n
 int main(int argc, char* argv[]) {
     std::string json_filename;
     int time_limit_ms = -1;
+    bool use_bundles = false;
 
     // Parse arguments
     for (int i = 1; i < argc; ++i) {
@@ -189,19 +230,22 @@ int main(int argc, char* argv[]) {
                 std::cerr << "Invalid time limit specified." << std::endl;
                 return 1;
             }
+        } else if (arg == "--bundles") {
+            use_bundles = true;
         }
     }
 
     if (time_limit_ms <= 0) {
-        std::cerr << "Usage: " << argv[0] << " --time <ms> [--json <filename>]" << std::endl;
+        std::cerr << "Usage: " << argv[0] << " --time <ms> [--json <filename>] [--bundles]" << std::endl;
         std::cerr << "Please specify a positive time limit in milliseconds." << std::endl;
+        std::cerr << "--bundles loads precomputed instance bundles (see 'make bundles') when present." << std::endl;
         return 1;
     }
 
     json results_json;
 
-    process_instance("../data/TSPA.csv", "TSPA", results_json, time_limit_ms);
-    process_instance("../data/TSPB.csv", "TSPB", results_json, time_limit_ms);
+    process_instance("../data/TSPA.csv", "TSPA", results_json, time_limit_ms, use_bundles);
+    process_instance("../data/TSPB.csv", "TSPB", results_json, time_limit_ms, use_bundles);
 
     if (!json_filename.empty()) {
         std::ofstream o(json_filename);
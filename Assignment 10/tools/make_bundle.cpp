@@ -0,0 +1,68 @@
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "core/data_loader.h"
+#include "core/point_data.h"
+#include "core/TSPProblem.h"
+#include "core/instance_bundle.h"
+
+// Converts an instance CSV into a precomputed bundle (points, distance matrix, candidate lists).
+// Usage: make_bundle <input.csv> <output.bundle> [K ...]
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <input.csv> <output.bundle> [K ...]" << std::endl;
+        std::cerr << "Stores candidate lists for every given K (default: 5 10 20)." << std::endl;
+        return 1;
+    }
+
+    std::vector<int> candidate_ks;
+    for (int i = 3; i < argc; ++i) {
+        try {
+            candidate_ks.push_back(std::stoi(argv[i]));
+        } catch (...) {
+            std::cerr << "Invalid K specified: " << argv[i] << std::endl;
+            return 1;
+        }
+    }
+    if (candidate_ks.empty()) {
+        candidate_ks = {5, 10, 20};
+    }
+
+    std::vector<PointData> data;
+    if (!load_data(argv[1], data)) {
+        return 1;
+    }
+
+    // The reader only accepts 0 < K < n, once per K; check here so no unreadable bundle is written
+    const int num_points = static_cast<int>(data.size());
+    for (size_t i = 0; i < candidate_ks.size(); ++i) {
+        const int k = candidate_ks[i];
+        if (k < 1 || k >= num_points) {
+            std::cerr << "Invalid K specified: " << k << " (must be between 1 and " << num_points - 1 << ")" << std::endl;
+            return 1;
+        }
+        if (std::find(candidate_ks.begin(), candidate_ks.begin() + i, k) != candidate_ks.begin() + i) {
+            std::cerr << "Duplicate K specified: " << k << std::endl;
+            return 1;
+        }
+    }
+
+    TSPProblem problem(data);
+    if (!write_instance_bundle(argv[2], problem, candidate_ks, argv[1])) {
+        return 1;
+    }
+
+    // Read the result back so a broken bundle is caught here rather than by the solver
+    InstanceBundle bundle;
+    if (!bundle.open(argv[2], true)) {
+        std::remove(argv[2]);
+        return 1;
+    }
+    std::cout << "Wrote " << argv[2] << ": " << bundle.num_points() << " points, "
+              << bundle.num_candidate_sets() << " candidate sets, content hash "
+              << std::hex << bundle.content_hash() << std::dec << std::endl;
+    return 0;
+}
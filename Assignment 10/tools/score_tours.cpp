@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "core/data_loader.h"
+#include "core/point_data.h"
+#include "core/TSPProblem.h"
+#include "core/batch_evaluation.h"
+
+// Start of anonymous namespace
+// Functions inside here are local to this file only and are not exported.
+namespace {
+
+// Parses one whole field as an integer, allowing surrounding whitespace (including the '\r'
+// of CRLF files); returns false for anything else instead of throwing like std::stoll
+bool parse_field(const std::string& field, long long& value) {
+    const char* p = field.data();
+    const char* end = p + field.size();
+    auto is_blank = [](char c) { return c == ' ' || c == '\t' || c == '\r'; };
+    while (p < end && is_blank(*p)) ++p;
+    std::from_chars_result result = std::from_chars(p, end, value);
+    if (result.ec != std::errc()) {
+        return false;
+    }
+    p = result.ptr;
+    while (p < end && is_blank(*p)) ++p;
+    return p == end;
+}
+
+}
+
+// Re-scores a solution archive in bulk (e.g. the 1000-tour files written by Assignment 8).
+// Each line holds comma-separated node ids followed by the objective recorded for that tour.
+// Usage: score_tours <instance.csv> <tours.csv> [output.csv]
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <instance.csv> <tours.csv> [output.csv]" << std::endl;
+        std::cerr << "Writes one recomputed objective per tour to output.csv when given." << std::endl;
+        return 1;
+    }
+
+    std::vector<PointData> data;
+    if (!load_data(argv[1], data)) {
+        return 1;
+    }
+    TSPProblem problem(data);
+
+    std::ifstream tours_file(argv[2]);
+    if (!tours_file.is_open()) {
+        std::cerr << "Error: could not open file " << argv[2] << std::endl;
+        return 1;
+    }
+
+    // Tours are packed into one contiguous block for the batch evaluator
+    std::vector<int> block;
+    std::vector<long long> recorded;
+    size_t tour_length = 0;
+    std::string line;
+    int line_number = 0;
+    while (std::getline(tours_file, line)) {
+        ++line_number;
+        std::vector<long long> fields;
+        std::stringstream ss(line);
+        std::string field;
+        bool numeric = true;
+        while (numeric && std::getline(ss, field, ',')) {
+            if (field.find_first_not_of(" \t\r") == std::string::npos) {
+                continue;
+            }
+            long long value;
+            numeric = parse_field(field, value);
+            fields.push_back(value);
+        }
+        if (!numeric) {
+            std::cerr << "Warning: skipping line " << line_number << " in " << argv[2]
+                      << " (non-numeric field '" << field << "')" << std::endl;
+            continue;
+        }
+        if (fields.size() < 2) {
+            continue;
+        }
+        if (tour_length == 0) {
+            tour_length = fields.size() - 1;
+        }
+        bool valid = fields.size() - 1 == tour_length;
+        for (size_t i = 0; valid && i < tour_length; ++i) {
+            valid = fields[i] >= 0 && fields[i] < problem.get_num_points();
+        }
+        if (!valid) {
+            std::cerr << "Warning: skipping malformed line " << line_number << " in " << argv[2] << std::endl;
+            continue;
+        }
+        block.insert(block.end(), fields.begin(), fields.end() - 1);
+        recorded.push_back(fields.back());
+    }
+
+    const size_t num_tours = recorded.size();
+    if (num_tours == 0) {
+        std::cerr << "Error: No tours loaded from " << argv[2] << std::endl;
+        return 1;
+    }
+
+    std::vector<double> objectives(num_tours);
+    auto start = std::chrono::steady_clock::now();
+    evaluate_solutions_batch(block.data(), num_tours, tour_length, problem, objectives.data());
+    double elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    size_t mismatches = 0;
+    double sum = 0.0;
+    for (size_t t = 0; t < num_tours; ++t) {
+        mismatches += (static_cast<long long>(objectives[t]) != recorded[t]);
+        sum += objectives[t];
+    }
+
+    std::cout << "Scored " << num_tours << " tours of " << tour_length << " nodes in " << elapsed_ms << " ms" << std::endl;
+    std::cout << "Min value: " << *std::min_element(objectives.begin(), objectives.end()) << std::endl;
+    std::cout << "Max value: " << *std::max_element(objectives.begin(), objectives.end()) << std::endl;
+    std::cout << "Avg value: " << sum / num_tours << std::endl;
+    std::cout << "Tours whose recorded objective differs: " << mismatches << std::endl;
+
+    if (argc > 3) {
+        std::ofstream out(argv[3]);
+        if (!out.is_open()) {
+            std::cerr << "Error: Could not open " << argv[3] << " for writing." << std::endl;
+            return 1;
+        }
+        for (double objective : objectives) {
+            out << static_cast<long long>(objective) << "\n";
+        }
+    }
+    return mismatches == 0 ? 0 : 2;
+}
@@ -8,6 +8,7 @@
 #include "random_solution.h"
 #include "nearest_neighbour_weighted_sum.h"
 #include "../core/stagetimer.h"
+#include "../core/spatial_index.h"
 #include "inter_node_exchange.h"
 #include "intra_edge_exchange.h"
 #include <iostream>
@@ -19,41 +20,22 @@
  * For each node, finds the K nearest neighbors where "nearest" means the sum of:
  * - The distance to that neighbor
  * - The cost of the neighbor node
+ * The neighbours are found with a k-d tree, so no full n x n list is built or sorted.
  * 
  * @param data The vector of point data.
- * @param distance_matrix The pre-calculated distance matrix.
  * @param K The number of nearest neighbors to store (default 10).
  * @return A vector where candidate_neighbors[i] contains the K nearest neighbor IDs for node i.
  */
 std::vector<std::vector<int>> precompute_candidate_neighbors(
     const std::vector<PointData>& data,
-    const std::vector<std::vector<int>>& distance_matrix,
     int K = 10
 ) {
     int n = data.size();
     std::vector<std::vector<int>> candidate_neighbors(n);
+    SpatialIndex index(data);
     
     for (int i = 0; i < n; ++i) {
-        // Create pairs of (cost, node_id) where cost = distance + node_cost
-        std::vector<std::pair<int, int>> neighbors;
-        neighbors.reserve(n - 1);
-        
-        for (int j = 0; j < n; ++j) {
-            if (i != j) {
-                int cost = distance_matrix[i][j] + data[j].cost;
-                neighbors.push_back({cost, j});
-            }
-        }
-        
-        // Sort by cost (ascending)
-        std::sort(neighbors.begin(), neighbors.end());
-        
-        // Take the K nearest
-        int actual_k = std::min(K, (int)neighbors.size());
-        candidate_neighbors[i].reserve(actual_k);
-        for (int k = 0; k < actual_k; ++k) {
-            candidate_neighbors[i].push_back(neighbors[k].second);
-        }
+        index.k_best_neighbors(i, K, candidate_neighbors[i]);
     }
     
     return candidate_neighbors;
@@ -101,7 +83,7 @@ std::vector<int> local_search(
 
     // Pre-compute candidate neighbors (done once)
     timer.start_stage("precompute candidates");
-    std::vector<std::vector<int>> candidate_neighbors = precompute_candidate_neighbors(data, distance_matrix, 10);
+    std::vector<std::vector<int>> candidate_neighbors = precompute_candidate_neighbors(data, 10);
     timer.end_stage();
 
     timer.start_stage("local traversing");
@@ -0,0 +1,144 @@
+#include "spatial_index.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Maximum number of points stored in a leaf
+const int LEAF_SIZE = 8;
+
+// Rounded Euclidean distance for a coordinate offset, matching the distance matrix
+int rounded_length(double dx, double dy) {
+    return static_cast<int>(std::round(std::sqrt(dx * dx + dy * dy)));
+}
+
+}
+
+SpatialIndex::SpatialIndex(const std::vector<PointData>& points) {
+    const int n = static_cast<int>(points.size());
+    std::vector<int> ids(n);
+    for (int i = 0; i < n; ++i) ids[i] = i;
+
+    nodes.reserve(2 * (n / LEAF_SIZE + 1));
+    if (n > 0) {
+        build(ids, 0, n, points);
+    }
+
+    slot_x.resize(n);
+    slot_y.resize(n);
+    slot_cost.resize(n);
+    slot_id.resize(n);
+    slot_of_id.resize(n);
+    for (int s = 0; s < n; ++s) {
+        const PointData& p = points[ids[s]];
+        slot_x[s] = p.x;
+        slot_y[s] = p.y;
+        slot_cost[s] = p.cost;
+        slot_id[s] = ids[s];
+        slot_of_id[ids[s]] = s;
+    }
+}
+
+int SpatialIndex::build(std::vector<int>& ids, int begin, int end, const std::vector<PointData>& points) {
+    Node node;
+    node.min_x = node.max_x = points[ids[begin]].x;
+    node.min_y = node.max_y = points[ids[begin]].y;
+    node.min_cost = points[ids[begin]].cost;
+    for (int s = begin + 1; s < end; ++s) {
+        const PointData& p = points[ids[s]];
+        node.min_x = std::min(node.min_x, p.x);
+        node.max_x = std::max(node.max_x, p.x);
+        node.min_y = std::min(node.min_y, p.y);
+        node.max_y = std::max(node.max_y, p.y);
+        node.min_cost = std::min(node.min_cost, p.cost);
+    }
+    node.begin = begin;
+    node.end = end;
+    node.left = node.right = -1;
+
+    int index = static_cast<int>(nodes.size());
+    nodes.push_back(node);
+    if (end - begin <= LEAF_SIZE) {
+        return index;
+    }
+
+    // Split at the median of the wider side of the bounding box
+    const bool split_x = (node.max_x - node.min_x) >= (node.max_y - node.min_y);
+    int mid = begin + (end - begin) / 2;
+    std::nth_element(ids.begin() + begin, ids.begin() + mid, ids.begin() + end,
+        [&](int a, int b) {
+            return split_x ? points[a].x < points[b].x : points[a].y < points[b].y;
+        });
+
+    int left = build(ids, begin, mid, points);
+    int right = build(ids, mid, end, points);
+    nodes[index].left = left;
+    nodes[index].right = right;
+    return index;
+}
+
+void SpatialIndex::k_best_neighbors(int query, int K, std::vector<int>& out) const {
+    out.clear();
+    const int n = static_cast<int>(slot_id.size());
+    K = std::min(K, n - 1);
+    if (K <= 0) return;
+
+    // Max-heap on (score, id): the front is the worst of the current K best
+    std::vector<std::pair<int, int>> heap;
+    heap.reserve(K + 1);
+    int s = slot_of_id[query];
+    search(0, slot_x[s], slot_y[s], query, K, heap);
+
+    std::sort_heap(heap.begin(), heap.end());
+    out.reserve(heap.size());
+    for (const auto& entry : heap) {
+        out.push_back(entry.second);
+    }
+}
+
+void SpatialIndex::search(int node_index, int query_x, int query_y, int query_id, int K,
+                          std::vector<std::pair<int, int>>& heap) const {
+    const Node& node = nodes[node_index];
+
+    if (node.left < 0) {
+        for (int s = node.begin; s < node.end; ++s) {
+            if (slot_id[s] == query_id) continue;
+            std::pair<int, int> entry(rounded_length(slot_x[s] - query_x, slot_y[s] - query_y) + slot_cost[s], slot_id[s]);
+            if (static_cast<int>(heap.size()) < K) {
+                heap.push_back(entry);
+                std::push_heap(heap.begin(), heap.end());
+            } else if (entry < heap.front()) {
+                std::pop_heap(heap.begin(), heap.end());
+                heap.back() = entry;
+                std::push_heap(heap.begin(), heap.end());
+            }
+        }
+        return;
+    }
+
+    // Lower bound of the score of any point in a subtree: distance to its box plus its cheapest cost.
+    // Rounding is monotonic, so the rounded box distance never exceeds a rounded point distance.
+    auto subtree_bound = [&](const Node& child) {
+        int dx = std::max(0, std::max(child.min_x - query_x, query_x - child.max_x));
+        int dy = std::max(0, std::max(child.min_y - query_y, query_y - child.max_y));
+        return rounded_length(dx, dy) + child.min_cost;
+    };
+
+    int first = node.left, second = node.right;
+    int first_bound = subtree_bound(nodes[first]);
+    int second_bound = subtree_bound(nodes[second]);
+    if (second_bound < first_bound) {
+        std::swap(first, second);
+        std::swap(first_bound, second_bound);
+    }
+
+    // A subtree is skipped only when its bound is strictly worse than the K-th best score,
+    // since an equal score with a smaller id would still displace the current entry
+    if (static_cast<int>(heap.size()) < K || first_bound <= heap.front().first) {
+        search(first, query_x, query_y, query_id, K, heap);
+    }
+    if (static_cast<int>(heap.size()) < K || second_bound <= heap.front().first) {
+        search(second, query_x, query_y, query_id, K, heap);
+    }
+}
@@ -5,296 +5,232 @@
 #include <random>
 #include <stdexcept>
 #include <limits>
-#include <set>
-#include <map>
 #include "random_solution.h"
 #include "../core/stagetimer.h"
 #include "../core/evaluation.h"
 #include "inter_node_exchange.h"
 #include "intra_edge_exchange.h"
 #include "neighborhood_utils.h"
+#include "move_list.h"
 
-// Enum to differentiate move types
-enum class MoveType {
-    INTRA,
-    INTER
-};
+const double epsilon = 1e-9;
 
-// Forward declaration
-struct MoveKey;
+// Start of anonymous namespace
+// Functions inside here are local to this file only and are not exported.
+namespace {
 
-// Structure to represent a move
-struct Move {
-    double delta;
-    MoveType type;
-    
-    // For INTRA moves (2-opt edge exchange)
-    int node_i;
-    int node_i_plus_1;
-    int node_j;
-    int node_j_plus_1;
-    
-    // For INTER moves (node exchange)
-    int node_in_solution;
-    int node_outside;
-    
-    // Constructor for intra moves
-    Move(double d, int ni, int nip1, int nj, int njp1)
-        : delta(d), type(MoveType::INTRA),
-          node_i(ni), node_i_plus_1(nip1), 
-          node_j(nj), node_j_plus_1(njp1),
-          node_in_solution(-1), node_outside(-1) {}
-    
-    // Constructor for inter moves
-    Move(double d, int nis, int no)
-        : delta(d), type(MoveType::INTER),
-          node_i(-1), node_i_plus_1(-1),
-          node_j(-1), node_j_plus_1(-1),
-          node_in_solution(nis), node_outside(no) {}
-
-    // Default constructor
-    Move() : delta(0.0), type(MoveType::INTRA),
-             node_i(-1), node_i_plus_1(-1),
-             node_j(-1), node_j_plus_1(-1),
-             node_in_solution(-1), node_outside(-1) {}
-    
-    // For sorted container - sort by delta, then by key for stability
-    bool operator<(const Move& other) const {
-        if (std::abs(delta - other.delta) > 1e-9) {
-            return delta < other.delta;
+/**
+ * @brief Solution state for the move-list search with O(1) node lookups.
+ */
+struct IndexedSolution {
+    std::vector<int> solution;
+    std::vector<int> not_in_solution;
+    std::vector<int> position;      ///< Node -> position in solution, -1 if outside.
+    std::vector<int> outside_index; ///< Node -> index in not_in_solution, -1 if in solution.
+
+    IndexedSolution(const std::vector<int>& starting_solution, int num_points)
+        : solution(starting_solution), position(num_points, -1), outside_index(num_points, -1) {
+        for (size_t i = 0; i < solution.size(); ++i) {
+            position[solution[i]] = i;
         }
-        // For equal deltas, compare by move details for stable ordering
-        if (type != other.type) return type < other.type;
-        if (type == MoveType::INTRA) {
-            if (node_i != other.node_i) return node_i < other.node_i;
-            if (node_i_plus_1 != other.node_i_plus_1) return node_i_plus_1 < other.node_i_plus_1;
-            if (node_j != other.node_j) return node_j < other.node_j;
-            return node_j_plus_1 < other.node_j_plus_1;
-        } else {
-            if (node_in_solution != other.node_in_solution) return node_in_solution < other.node_in_solution;
-            return node_outside < other.node_outside;
+        for (int node = 0; node < num_points; ++node) {
+            if (position[node] == -1) {
+                outside_index[node] = not_in_solution.size();
+                not_in_solution.push_back(node);
+            }
         }
     }
-};
 
-// Unique, order-independent identifier for a move
-struct MoveKey {
-    MoveType type;
-    int a, b, c, d;
-    
-    MoveKey(const Move& move) {
-        type = move.type;
-        if (type == MoveType::INTRA) {
-            int edge1_a = std::min(move.node_i, move.node_i_plus_1);
-            int edge1_b = std::max(move.node_i, move.node_i_plus_1);
-            int edge2_a = std::min(move.node_j, move.node_j_plus_1);
-            int edge2_b = std::max(move.node_j, move.node_j_plus_1);
-            
-            if (edge1_a < edge2_a || (edge1_a == edge2_a && edge1_b < edge2_b)) {
-                a = edge1_a; b = edge1_b; c = edge2_a; d = edge2_b;
-            } else {
-                a = edge2_a; b = edge2_b; c = edge1_a; d = edge1_b;
-            }
-        } else {
-            a = std::min(move.node_in_solution, move.node_outside);
-            b = std::max(move.node_in_solution, move.node_outside);
-            c = -1; d = -1;
-        }
+    int next_node(int node) const {
+        const int p = position[node] + 1;
+        return solution[(p == static_cast<int>(solution.size())) ? 0 : p];
     }
 
-    MoveKey(MoveType t, int n1, int n2, int n3 = -1, int n4 = -1) {
-        type = t;
-        if (type == MoveType::INTRA) {
-            int edge1_a = std::min(n1, n2);
-            int edge1_b = std::max(n1, n2);
-            int edge2_a = std::min(n3, n4);
-            int edge2_b = std::max(n3, n4);
-            if (edge1_a < edge2_a || (edge1_a == edge2_a && edge1_b < edge2_b)) {
-                a = edge1_a; b = edge1_b; c = edge2_a; d = edge2_b;
-            } else {
-                a = edge2_a; b = edge2_b; c = edge1_a; d = edge1_b;
-            }
-        } else {
-            a = std::min(n1, n2);
-            b = std::max(n1, n2);
-            c = -1; d = -1;
+    int prev_node(int node) const {
+        const int p = position[node];
+        return solution[(p == 0) ? solution.size() - 1 : p - 1];
+    }
+
+    // Reverses `length` positions starting at `start` (wrapping) and keeps `position` in sync
+    void reverse(int start, int length) {
+        const int solution_size = solution.size();
+        int i = start;
+        int j = (start + length - 1) % solution_size;
+        for (int k = 0; k < length / 2; ++k) {
+            std::swap(solution[i], solution[j]);
+            position[solution[i]] = i;
+            position[solution[j]] = j;
+            i = (i + 1) % solution_size;
+            j = (j - 1 + solution_size) % solution_size;
         }
     }
-    
-    bool operator<(const MoveKey& other) const {
-        if (type != other.type) return type < other.type;
-        if (a != other.a) return a < other.a;
-        if (b != other.b) return b < other.b;
-        if (c != other.c) return c < other.c;
-        return d < other.d;
+
+    // Replaces the node at `pos` with the outside node `node_in`
+    void exchange(int pos, int node_in) {
+        const int node_out = solution[pos];
+        const int index = outside_index[node_in];
+        solution[pos] = node_in;
+        position[node_in] = pos;
+        position[node_out] = -1;
+        not_in_solution[index] = node_out;
+        outside_index[node_out] = index;
+        outside_index[node_in] = -1;
     }
 };
 
-// Dual data structure for efficient move management
-class MoveManager {
-private:
-    std::map<MoveKey, Move> move_map;           // For O(log n) lookup/update by key
-    std::multiset<Move> sorted_moves;            // For O(log n) access to best move
-    const double epsilon = 1e-9;
-
+/**
+ * @brief Generates moves on an IndexedSolution and keeps the MoveList in step with it.
+ */
+class MoveListSearch {
 public:
-    // Insert or update a move
-    void update(const Move& move) {
-        MoveKey key(move);
-        
-        // Check if move already exists
-        auto it = move_map.find(key);
-        if (it != move_map.end()) {
-            // Remove old version from sorted set
-            sorted_moves.erase(sorted_moves.find(it->second));
+    MoveListSearch(TSPProblem& problem_instance, IndexedSolution& state)
+        : problem(problem_instance), state(state), LM(problem_instance.get_num_points()),
+          node_cost(problem_instance.get_num_points()) {
+        for (int node = 0; node < problem.get_num_points(); ++node) {
+            node_cost[node] = problem.get_point(node).cost;
         }
-        
-        // Insert new version
-        move_map[key] = move;
-        sorted_moves.insert(move);
     }
-    
-    // Remove a move by key
-    void remove(const MoveKey& key) {
-        auto it = move_map.find(key);
-        if (it != move_map.end()) {
-            sorted_moves.erase(sorted_moves.find(it->second));
-            move_map.erase(it);
+
+    // Evaluates the whole neighbourhood once
+    void add_all_moves() {
+        const std::vector<int>& solution = state.solution;
+        const int solution_size = solution.size();
+        for (int i = 0; i < solution_size; ++i) {
+            const int a = solution[i];
+            const int b = solution[(i + 1) % solution_size];
+            // Skip the pair of edges that share a node across the end of the tour
+            const int last = (i == 0) ? solution_size - 1 : solution_size;
+            for (int j = i + 2; j < last; ++j) {
+                add_intra_pair(a, b, solution[j], solution[(j + 1) % solution_size]);
+            }
+        }
+        for (int node : solution) {
+            add_inter_moves_for_node(node);
         }
     }
-    
-    // Get iterator to best (smallest delta) move
-    std::multiset<Move>::iterator begin_sorted() {
-        return sorted_moves.begin();
-    }
-    
-    std::multiset<Move>::iterator end_sorted() {
-        return sorted_moves.end();
-    }
-    
-    // Check if any improving moves exist
-    bool has_improving_move() const {
-        return !sorted_moves.empty() && sorted_moves.begin()->delta < -epsilon;
-    }
-    
-    size_t size() const {
-        return move_map.size();
+
+    /**
+     * @brief Returns the best applicable move, or -1 if there is none.
+     * @param reversed Output: for INTRA moves, whether both edges are traversed backwards.
+     */
+    int find_best_move(bool& reversed) {
+        for (int id = LM.first(); id != -1; id = LM.next(id)) {
+            const MoveRecord& move = LM.get(id);
+            // Stored inter moves always apply: their edges and the outside node are checked on removal
+            if (move.type == MoveType::INTER) return id;
+
+            // Both edges exist; 2-opt applies only if they are traversed in the same direction
+            const bool forward1 = state.next_node(move.nodes[0]) == move.nodes[1];
+            const bool forward2 = state.next_node(move.nodes[2]) == move.nodes[3];
+            if (forward1 == forward2) {
+                reversed = !forward1;
+                return id;
+            }
+        }
+        return -1;
     }
-    
-    void clear() {
-        move_map.clear();
-        sorted_moves.clear();
+
+    void apply_move(int id, bool reversed) {
+        const MoveRecord move = LM.get(id);
+        if (move.type == MoveType::INTRA) {
+            apply_intra(move.nodes[0], move.nodes[1], move.nodes[2], move.nodes[3], reversed);
+        } else {
+            apply_inter(move.nodes[0], move.nodes[1], move.nodes[2], move.nodes[3]);
+        }
     }
-};
 
-const double epsilon = 1e-9;
+private:
+    int distance(int u, int v) const { return problem.get_distance(u, v); }
 
-// Check if intra move edges exist with same orientation
-int check_edge_orientation(const std::vector<int>& solution, const Move& move) {
-    const int solution_size = solution.size();
-    if (solution_size < 3) return 0;
+    // Stores both 2-opt moves on the edges (a, b) and (c, d): which one applies depends on
+    // their relative direction, which later reversals may flip
+    void add_intra_pair(int a, int b, int c, int d) {
+        const int removed = distance(a, b) + distance(c, d);
+        LM.add_intra(distance(a, c) + distance(b, d) - removed, a, b, c, d);
+        LM.add_intra(distance(a, d) + distance(b, c) - removed, a, b, d, c);
+    }
 
-    int current_pos_i = -1;
-    for (int i = 0; i < solution_size; ++i) {
-        if (solution[i] == move.node_i) {
-            current_pos_i = i;
-            break;
+    // Pairs the tour edge (u, v) with every other tour edge, skipping the edge (skip_u, skip_v)
+    void add_intra_moves_for_edge(int u, int v, int skip_u = -1, int skip_v = -1) {
+        const std::vector<int>& solution = state.solution;
+        const int solution_size = solution.size();
+        for (int i = 0; i < solution_size; ++i) {
+            const int c = solution[i];
+            const int d = solution[(i + 1) % solution_size];
+            if (c == u || c == v || d == u || d == v) continue;
+            if ((c == skip_u && d == skip_v) || (c == skip_v && d == skip_u)) continue;
+            add_intra_pair(u, v, c, d);
         }
     }
-    if (current_pos_i == -1) return 0;
-    
-    int next_i_node = solution[(current_pos_i + 1) % solution_size];
-    int prev_i_node = solution[(current_pos_i - 1 + solution_size) % solution_size];
-    
-    int current_pos_j = -1;
-    for (int i = 0; i < solution_size; ++i) {
-        if (solution[i] == move.node_j) {
-            current_pos_j = i;
-            break;
+
+    // Exchanges of the tour node b with every outside node
+    void add_inter_moves_for_node(int b) {
+        const int a = state.prev_node(b);
+        const int c = state.next_node(b);
+        const int removed = distance(a, b) + distance(b, c) + node_cost[b];
+        for (int x : state.not_in_solution) {
+            LM.add_inter(distance(a, x) + distance(x, c) + node_cost[x] - removed, a, b, c, x);
         }
     }
-    if (current_pos_j == -1) return 0;
 
-    int next_j_node = solution[(current_pos_j + 1) % solution_size];
-    int prev_j_node = solution[(current_pos_j - 1 + solution_size) % solution_size];
-    
-    bool edge1_exists = (next_i_node == move.node_i_plus_1);
-    bool edge1_reversed = (prev_i_node == move.node_i_plus_1);
-    bool edge2_exists = (next_j_node == move.node_j_plus_1);
-    bool edge2_reversed = (prev_j_node == move.node_j_plus_1);
-    
-    if (!edge1_exists && !edge1_reversed) return 0;
-    if (!edge2_exists && !edge2_reversed) return 0;
-    
-    if (edge1_exists && edge2_exists) return 1;
-    if (edge1_reversed && edge2_reversed) return 1;
-    
-    return -1;
-}
-
-// Check if inter move is applicable
-bool check_inter_move_applicable(const std::vector<int>& solution, 
-                                  const std::vector<int>& not_in_solution,
-                                  const Move& move) {
-    bool in_sol = false;
-    for (size_t i = 0; i < solution.size(); ++i) {
-        if (solution[i] == move.node_in_solution) {
-            in_sol = true;
-            break;
+    // Exchanges of the outside node x with every tour node except the ones in `skip`
+    void add_inter_moves_for_outside(int x, const int* skip, int num_skip) {
+        for (int b : state.solution) {
+            if (std::find(skip, skip + num_skip, b) != skip + num_skip) continue;
+            const int a = state.prev_node(b);
+            const int c = state.next_node(b);
+            LM.add_inter(distance(a, x) + distance(x, c) + node_cost[x] - distance(a, b) - distance(b, c) - node_cost[b],
+                         a, b, c, x);
         }
     }
-    if (!in_sol) return false;
-    
-    bool outside = false;
-    for (size_t i = 0; i < not_in_solution.size(); ++i) {
-        if (not_in_solution[i] == move.node_outside) {
-            outside = true;
-            break;
+
+    void apply_intra(int a, int b, int c, int d, bool reversed) {
+        LM.remove_edge(a, b);
+        LM.remove_edge(c, d);
+
+        // The tour runs a -> b ... c -> d (or d -> c ... b -> a); reverse the shorter side
+        const int solution_size = state.solution.size();
+        const int pos1 = reversed ? state.position[d] : state.position[a];
+        const int pos2 = reversed ? state.position[b] : state.position[c];
+        const int inner_length = (pos2 - pos1 + solution_size) % solution_size;
+        if (inner_length <= solution_size - inner_length) {
+            state.reverse((pos1 + 1) % solution_size, inner_length);
+        } else {
+            state.reverse((pos2 + 1) % solution_size, solution_size - inner_length);
         }
+
+        // New edges (a, c) and (b, d); only the nodes touching them have new neighbours
+        add_intra_moves_for_edge(a, c);
+        add_intra_moves_for_edge(b, d, a, c);
+        add_inter_moves_for_node(a);
+        add_inter_moves_for_node(b);
+        add_inter_moves_for_node(c);
+        add_inter_moves_for_node(d);
     }
-    if (!outside) return false;
-    
-    return true;
-}
 
-// Re-evaluate and update intra move
-void reevaluate_and_update_intra(
-    TSPProblem& problem_instance,
-    const std::vector<int>& solution,
-    int pos1, int pos2,
-    MoveManager& LM
-) {
-    const int solution_size = solution.size();
-    if (solution_size < 3) return;
-    if (pos1 == pos2) return;
-    
-    double delta = intra_edge_exchange(problem_instance, solution, pos1, pos2);
-    
-    int pos1_plus_1 = (pos1 + 1) % solution_size;
-    int pos2_plus_1 = (pos2 + 1) % solution_size;
-    
-    Move move(delta, solution[pos1], solution[pos1_plus_1],
-              solution[pos2], solution[pos2_plus_1]);
-    
-    LM.update(move);
-}
+    void apply_inter(int a, int b, int c, int x) {
+        LM.remove_edge(a, b);
+        LM.remove_edge(b, c);
+        LM.remove_outside_node(x);
+        state.exchange(state.position[b], x);
 
-// Re-evaluate and update inter move
-void reevaluate_and_update_inter(
-    TSPProblem& problem_instance,
-    const std::vector<int>& solution,
-    const std::vector<int>& not_in_solution,
-    int sol_idx, int out_node_id,
-    MoveManager& LM
-) {
-    double delta = inter_node_exchange(problem_instance, 
-                                      const_cast<std::vector<int>&>(solution),
-                                      sol_idx, out_node_id);
-    
-    Move move(delta, solution[sol_idx], out_node_id);
-    LM.update(move);
-}
+        // New edges (a, x) and (x, c); they share x, so they are never paired with each other
+        add_intra_moves_for_edge(a, x);
+        add_intra_moves_for_edge(x, c);
+        add_inter_moves_for_node(a);
+        add_inter_moves_for_node(x);
+        add_inter_moves_for_node(c);
+        const int updated[3] = {a, x, c};
+        add_inter_moves_for_outside(b, updated, 3);
+    }
 
+    TSPProblem& problem;
+    IndexedSolution& state;
+    MoveList LM;
+    std::vector<int> node_cost;
+};
+
+}
 
 std::vector<int> local_search(
     TSPProblem& problem_instance,
@@ -395,183 +331,25 @@ std::vector<int> local_search(
         return solution;
     }
     
-    // STEEPEST implementation with MoveManager
-    std::vector<int> solution = starting_solution;
+    // STEEPEST implementation with the move list (LM)
     timer.start_stage("local traversing");
-    
-    std::vector<int> not_in_solution;
-    const int solution_size = solution.size();
-    
-    // Build not_in_solution list
-    for (int i = 0; i < problem_instance.get_num_points(); ++i) {
-        bool in_solution = false;
-        for (int j = 0; j < solution_size; ++j) {
-            if (solution[j] == i) {
-                in_solution = true;
-                break;
-            }
-        }
-        if (!in_solution) {
-            not_in_solution.push_back(i);
-        }
-    }
-    
-    // MoveManager: combines map for updates and multiset for sorted access
-    MoveManager LM;
-    
-    // Initial evaluation: evaluate all moves
-    if (solution_size >= 2) {
-        for (int i = 0; i < solution_size; ++i) {
-            for (int j = i + 1; j < solution_size; ++j) {
-                reevaluate_and_update_intra(problem_instance, solution, i, j, LM);
-            }
-        }
-    }
-    
-    for (int sol_idx = 0; sol_idx < solution_size; ++sol_idx) {
-        for (size_t out_idx = 0; out_idx < not_in_solution.size(); ++out_idx) {
-            reevaluate_and_update_inter(problem_instance, solution, not_in_solution,
-                                       sol_idx, not_in_solution[out_idx], LM);
-        }
+
+    IndexedSolution state(starting_solution, problem_instance.get_num_points());
+    if (state.solution.size() < 3) {
+        timer.end_stage();
+        return state.solution;
     }
-    
-    // Main loop
-    while (LM.has_improving_move()) {
-        bool move_found = false;
-        Move best_move;
-        
-        // Iterate through sorted moves (best first)
-        for (auto it = LM.begin_sorted(); it != LM.end_sorted(); ++it) {
-            const Move& move = *it;
-            
-            // Stop if we've passed all improving moves
-            if (move.delta >= -epsilon) break;
-            
-            if (move.type == MoveType::INTRA) {
-                int orientation = check_edge_orientation(solution, move);
-                if (orientation == 0) {
-                    // Edges don't exist - mark for removal
-                    LM.remove(MoveKey(move));
-                    continue;
-                } else if (orientation == -1) {
-                    // Different orientation - not applicable now
-                    continue;
-                }
-                // orientation == 1: applicable
-                best_move = move;
-                move_found = true;
-                break;
-            } else {
-                // INTER move
-                if (!check_inter_move_applicable(solution, not_in_solution, move)) {
-                    // Move is invalid - mark for removal
-                    LM.remove(MoveKey(move));
-                    continue;
-                }
-                best_move = move;
-                move_found = true;
-                break;
-            }
-        }
-        
-        if (!move_found) {
-            break; // Local optimum reached
-        }
-        
-        // Apply the best applicable move
-        if (best_move.type == MoveType::INTRA) {
-            // Apply intra move
-            int current_pos1 = -1, current_pos2 = -1;
-            for (int i = 0; i < solution_size; ++i) {
-                if (solution[i] == best_move.node_i) current_pos1 = i;
-                if (solution[i] == best_move.node_j) current_pos2 = i;
-            }
-            
-            if (current_pos1 == -1 || current_pos2 == -1) continue;
-            
-            apply_intra_edge_exchange(solution, current_pos1, current_pos2);
-            
-            // Identify 4 affected nodes
-            int n_i = best_move.node_i;
-            int n_i_plus_1 = best_move.node_i_plus_1;
-            int n_j = best_move.node_j;
-            int n_j_plus_1 = best_move.node_j_plus_1;
-            
-            // Find their new positions
-            int pos_i = -1, pos_i_plus_1 = -1, pos_j = -1, pos_j_plus_1 = -1;
-            for(int i=0; i < solution_size; ++i) {
-                if (solution[i] == n_i) pos_i = i;
-                if (solution[i] == n_i_plus_1) pos_i_plus_1 = i;
-                if (solution[i] == n_j) pos_j = i;
-                if (solution[i] == n_j_plus_1) pos_j_plus_1 = i;
-            }
-            
-            // Re-evaluate intra moves involving the 4 affected nodes
-            for (int other_pos = 0; other_pos < solution_size; ++other_pos) {
-                reevaluate_and_update_intra(problem_instance, solution, pos_i, other_pos, LM);
-                reevaluate_and_update_intra(problem_instance, solution, pos_i_plus_1, other_pos, LM);
-                reevaluate_and_update_intra(problem_instance, solution, pos_j, other_pos, LM);
-                reevaluate_and_update_intra(problem_instance, solution, pos_j_plus_1, other_pos, LM);
-            }
-            
-            // Re-evaluate inter moves for the 4 affected nodes
-            for (size_t out_idx = 0; out_idx < not_in_solution.size(); ++out_idx) {
-                reevaluate_and_update_inter(problem_instance, solution, not_in_solution, pos_i, not_in_solution[out_idx], LM);
-                reevaluate_and_update_inter(problem_instance, solution, not_in_solution, pos_i_plus_1, not_in_solution[out_idx], LM);
-                reevaluate_and_update_inter(problem_instance, solution, not_in_solution, pos_j, not_in_solution[out_idx], LM);
-                reevaluate_and_update_inter(problem_instance, solution, not_in_solution, pos_j_plus_1, not_in_solution[out_idx], LM);
-            }
-            
-        } else {
-            // Apply inter move
-            int sol_pos = -1;
-            for (int i = 0; i < solution_size; ++i) {
-                if (solution[i] == best_move.node_in_solution) {
-                    sol_pos = i;
-                    break;
-                }
-            }
-            
-            int out_pos = -1;
-            for(size_t i=0; i < not_in_solution.size(); ++i) {
-                if (not_in_solution[i] == best_move.node_outside) {
-                    out_pos = i;
-                    break;
-                }
-            }
-            
-            if (sol_pos == -1 || out_pos == -1) continue;
-            
-            // Get neighbors BEFORE swap
-            int pos_before = (sol_pos - 1 + solution_size) % solution_size;
-            int pos_after = (sol_pos + 1) % solution_size;
-            
-            int node_that_left = solution[sol_pos];
-            int node_that_entered = not_in_solution[out_pos];
-            
-            // Apply the exchange
-            solution[sol_pos] = node_that_entered;
-            not_in_solution[out_pos] = node_that_left;
-            
-            // Re-evaluate inter moves
-            for (size_t out_idx = 0; out_idx < not_in_solution.size(); ++out_idx) {
-                reevaluate_and_update_inter(problem_instance, solution, not_in_solution, sol_pos, not_in_solution[out_idx], LM);
-                reevaluate_and_update_inter(problem_instance, solution, not_in_solution, pos_before, not_in_solution[out_idx], LM);
-                reevaluate_and_update_inter(problem_instance, solution, not_in_solution, pos_after, not_in_solution[out_idx], LM);
-            }
-            
-            for (int in_idx = 0; in_idx < solution_size; ++in_idx) {
-                reevaluate_and_update_inter(problem_instance, solution, not_in_solution, in_idx, node_that_left, LM);
-            }
-            
-            // Re-evaluate intra moves involving the 2 new edges
-            for (int other_pos = 0; other_pos < solution_size; ++other_pos) {
-                reevaluate_and_update_intra(problem_instance, solution, pos_before, other_pos, LM);
-                reevaluate_and_update_intra(problem_instance, solution, sol_pos, other_pos, LM);
-            }
-        }
+
+    MoveListSearch search(problem_instance, state);
+    search.add_all_moves();
+
+    // Apply the best applicable move until none is left
+    bool reversed = false;
+    int move_id;
+    while ((move_id = search.find_best_move(reversed)) != -1) {
+        search.apply_move(move_id, reversed);
     }
-    
+
     timer.end_stage();
-    return solution;
+    return state.solution;
 }
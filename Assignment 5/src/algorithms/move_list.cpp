@@ -0,0 +1,179 @@
+#include "move_list.h"
+
+#include <vector>
+#include <algorithm>
+
+MoveList::MoveList(int num_nodes)
+    : free_head(-1), top_bucket(-1), num_nodes(num_nodes),
+      edge_other(2 * num_nodes, -1), handle_heads(3 * num_nodes, -1) {}
+
+void MoveList::add_intra(int delta, int a, int b, int c, int d) {
+    if (delta >= 0) return;
+    const int edge1 = get_edge_handle(a, b);
+    const int edge2 = get_edge_handle(c, d);
+    if (edge1 == -1 || edge2 == -1) return;
+
+    const int id = allocate(delta, MoveType::INTRA, a, b, c, d);
+    attach(id, 0, edge1);
+    attach(id, 1, edge2);
+}
+
+void MoveList::add_inter(int delta, int a, int b, int c, int d) {
+    if (delta >= 0) return;
+    const int edge1 = get_edge_handle(a, b);
+    const int edge2 = get_edge_handle(b, c);
+    if (edge1 == -1 || edge2 == -1) return;
+
+    const int id = allocate(delta, MoveType::INTER, a, b, c, d);
+    attach(id, 0, edge1);
+    attach(id, 1, edge2);
+    attach(id, 2, 2 * num_nodes + d);
+}
+
+void MoveList::remove_edge(int u, int v) {
+    const int handle = find_edge_handle(u, v);
+    if (handle == -1) return;
+    release_all(handle);
+    edge_other[handle] = -1;
+}
+
+void MoveList::remove_outside_node(int node) {
+    release_all(2 * num_nodes + node);
+}
+
+int MoveList::first() {
+    while (top_bucket >= 0 && bucket_heads[top_bucket] == -1) {
+        top_bucket--;
+    }
+    return (top_bucket >= 0) ? bucket_heads[top_bucket] : -1;
+}
+
+int MoveList::next(int id) const {
+    const MoveRecord& record = records[id];
+    if (record.bucket_next != -1) return record.bucket_next;
+    for (int bucket = record.bucket - 1; bucket >= 0; --bucket) {
+        if (bucket_heads[bucket] != -1) return bucket_heads[bucket];
+    }
+    return -1;
+}
+
+int MoveList::allocate(int delta, MoveType type, int a, int b, int c, int d) {
+    int id;
+    if (free_head != -1) {
+        id = free_head;
+        free_head = records[id].bucket_next;
+    } else {
+        id = records.size();
+        records.push_back(MoveRecord());
+    }
+
+    MoveRecord& record = records[id];
+    record.delta = delta;
+    record.type = type;
+    record.nodes[0] = a;
+    record.nodes[1] = b;
+    record.nodes[2] = c;
+    record.nodes[3] = d;
+    for (int slot = 0; slot < 3; ++slot) {
+        record.handles[slot] = -1;
+    }
+
+    // Push onto the front of its bucket
+    const int bucket = -delta - 1;
+    if (bucket >= static_cast<int>(bucket_heads.size())) {
+        bucket_heads.resize(bucket + 1, -1);
+    }
+    record.bucket = bucket;
+    record.bucket_prev = -1;
+    record.bucket_next = bucket_heads[bucket];
+    if (record.bucket_next != -1) {
+        records[record.bucket_next].bucket_prev = id;
+    }
+    bucket_heads[bucket] = id;
+    top_bucket = std::max(top_bucket, bucket);
+    return id;
+}
+
+void MoveList::attach(int id, int slot, int handle) {
+    MoveRecord& record = records[id];
+    record.handles[slot] = handle;
+    record.handle_prev[slot] = -1;
+    record.handle_next[slot] = handle_heads[handle];
+    if (record.handle_next[slot] != -1) {
+        MoveRecord& next_record = records[record.handle_next[slot]];
+        for (int s = 0; s < 3; ++s) {
+            if (next_record.handles[s] == handle) next_record.handle_prev[s] = id;
+        }
+    }
+    handle_heads[handle] = id;
+}
+
+void MoveList::release(int id) {
+    MoveRecord& record = records[id];
+
+    // Unlink from the bucket
+    if (record.bucket_prev != -1) {
+        records[record.bucket_prev].bucket_next = record.bucket_next;
+    } else {
+        bucket_heads[record.bucket] = record.bucket_next;
+    }
+    if (record.bucket_next != -1) {
+        records[record.bucket_next].bucket_prev = record.bucket_prev;
+    }
+
+    // Unlink from every handle list; a record never uses the same handle twice
+    for (int slot = 0; slot < 3; ++slot) {
+        const int handle = record.handles[slot];
+        if (handle == -1) continue;
+        const int prev = record.handle_prev[slot];
+        const int next = record.handle_next[slot];
+        if (prev != -1) {
+            MoveRecord& prev_record = records[prev];
+            for (int s = 0; s < 3; ++s) {
+                if (prev_record.handles[s] == handle) prev_record.handle_next[s] = next;
+            }
+        } else {
+            handle_heads[handle] = next;
+        }
+        if (next != -1) {
+            MoveRecord& next_record = records[next];
+            for (int s = 0; s < 3; ++s) {
+                if (next_record.handles[s] == handle) next_record.handle_prev[s] = prev;
+            }
+        }
+    }
+
+    record.bucket = -1;
+    record.bucket_next = free_head;
+    free_head = id;
+}
+
+void MoveList::release_all(int handle) {
+    while (handle_heads[handle] != -1) {
+        release(handle_heads[handle]);
+    }
+}
+
+int MoveList::find_edge_handle(int u, int v) const {
+    const int owner = std::min(u, v);
+    const int other = std::max(u, v);
+    for (int k = 0; k < 2; ++k) {
+        if (edge_other[2 * owner + k] == other) return 2 * owner + k;
+    }
+    return -1;
+}
+
+int MoveList::get_edge_handle(int u, int v) {
+    const int handle = find_edge_handle(u, v);
+    if (handle != -1) return handle;
+
+    const int owner = std::min(u, v);
+    for (int k = 0; k < 2; ++k) {
+        if (edge_other[2 * owner + k] == -1) {
+            edge_other[2 * owner + k] = std::max(u, v);
+            return 2 * owner + k;
+        }
+    }
+    // Both edges of the owner are still registered: the caller did not remove a dead edge
+    return -1;
+}
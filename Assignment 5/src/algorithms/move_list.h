@@ -0,0 +1,109 @@
+#ifndef MOVE_LIST_H
+#define MOVE_LIST_H
+
+#include <vector>
+
+/**
+ * @brief Differentiates the two kinds of moves stored in the move list.
+ */
+enum class MoveType {
+    INTRA, ///< 2-opt: edges (a, b) and (c, d) are replaced by (a, c) and (b, d).
+    INTER  ///< Node exchange: node b between a and c is replaced by the outside node d.
+};
+
+/**
+ * @brief A pooled move record.
+ *
+ * The delta of a move depends only on the nodes it names, so a record never needs to be
+ * re-evaluated: it stays valid exactly as long as its edges are in the tour (and, for INTER
+ * moves, its outside node is still outside). Each record is linked into the lists of up to
+ * three handles (its two edges and the outside node) so that it can be dropped in O(1) when
+ * any of them disappears.
+ */
+struct MoveRecord {
+    int delta;
+    MoveType type;
+    int nodes[4];         ///< INTRA: a, b, c, d.  INTER: a (before), b (in solution), c (after), d (outside).
+
+    int bucket;           ///< Bucket index, -1 while the record is on the free list.
+    int bucket_prev, bucket_next;
+
+    int handles[3];       ///< Edge, edge and outside-node handle (-1 if unused).
+    int handle_prev[3], handle_next[3];
+};
+
+/**
+ * @brief List of improving moves for the move-list (LM) local search.
+ *
+ * Moves are kept in an integer-delta bucket queue: bucket i holds the moves with delta -(i + 1),
+ * so the best move is in the highest non-empty bucket and insertion and removal are O(1).
+ * Records live in one flat pool with a free list, so no allocation happens once the pool has
+ * grown to its working size.
+ *
+ * Only improving moves (delta < 0) are stored.
+ */
+class MoveList {
+public:
+    /**
+     * @brief Constructor for the MoveList.
+     * @param num_nodes The number of nodes in the problem.
+     */
+    MoveList(int num_nodes);
+
+    /**
+     * @brief Adds an intra move replacing the tour edges (a, b) and (c, d) with (a, c) and (b, d).
+     * Does nothing if the move is not improving.
+     */
+    void add_intra(int delta, int a, int b, int c, int d);
+
+    /**
+     * @brief Adds an inter move replacing node b (between a and c) with the outside node d.
+     * Does nothing if the move is not improving.
+     */
+    void add_inter(int delta, int a, int b, int c, int d);
+
+    /**
+     * @brief Drops every move that uses the edge (u, v); call it when the edge leaves the tour.
+     */
+    void remove_edge(int u, int v);
+
+    /**
+     * @brief Drops every inter move that inserts `node`; call it when the node enters the tour.
+     */
+    void remove_outside_node(int node);
+
+    /**
+     * @brief Returns the best stored move, or -1 if the list is empty.
+     */
+    int first();
+
+    /**
+     * @brief Returns the move after `id` in best-first order, or -1 if there is none.
+     */
+    int next(int id) const;
+
+    const MoveRecord& get(int id) const { return records[id]; }
+
+private:
+    int allocate(int delta, MoveType type, int a, int b, int c, int d);
+    void attach(int id, int slot, int handle);
+    void release(int id);
+    void release_all(int handle);
+    int find_edge_handle(int u, int v) const;
+    int get_edge_handle(int u, int v);
+
+    std::vector<MoveRecord> records;
+    int free_head;
+
+    std::vector<int> bucket_heads;
+    int top_bucket;
+
+    // Edge (u, v) is owned by min(u, v), which has at most two tour edges at a time:
+    // handle 2 * owner + k belongs to the edge to edge_other[2 * owner + k].
+    // Handles from 2 * num_nodes on belong to outside nodes.
+    int num_nodes;
+    std::vector<int> edge_other;
+    std::vector<int> handle_heads;
+};
+
+#endif // MOVE_LIST_H